@@ -0,0 +1,98 @@
+// Shows that priority aging adds no per-pop work and ends starvation.
+// The first table times a steady pop-then-push workload on the binary heap
+// with aging off and at two aging intervals. Aged ranks are all distinct,
+// so ties no longer end a sift early. The "distinct" row turns aging off
+// but draws priorities from a wide range; it shows that shape costs the
+// same without aging. The second table keeps urgent tasks arriving and
+// counts the pops before one priority-100 task finally runs.
+// Pass a maximum queue size to skip the larger runs on small machines.
+//
+// Build: cmake -S . -B build && cmake --build build --target bench_aging
+
+#include "binary_heap_queue.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+volatile long long sink;  // Keeps the popped values observable
+
+double nsPerPop(int agingInterval, int maxPriority, size_t queueSize, size_t pops) {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> priorityDist(1, maxPriority);
+    std::vector<int> priorities(queueSize + pops);
+    for (auto& p : priorities) p = priorityDist(rng);
+
+    BinaryHeapQueue heap(agingInterval);
+    std::vector<Task> initial;
+    initial.reserve(queueSize);
+    for (size_t i = 0; i < queueSize; ++i) {
+        initial.emplace_back(static_cast<int>(i + 1), "bench", priorities[i]);
+    }
+    heap.pushBatch(std::move(initial));
+
+    // Each pop is followed by a push so the queue size stays fixed
+    long long checksum = 0;
+    int nextId = static_cast<int>(queueSize) + 1;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < pops; ++i) {
+        checksum += heap.pop().getPriority();
+        heap.push(Task(nextId++, "bench", priorities[queueSize + i]));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    sink = checksum;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / pops;
+}
+
+// Pops until the single priority-100 task runs while priority 1-10 tasks
+// keep arriving; 0 means it was still waiting after limit pops
+size_t popsUntilLowPriorityRuns(int agingInterval, size_t limit) {
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<int> urgent(1, 10);
+    BinaryHeapQueue heap(agingInterval);
+    heap.push(Task(1, "low", 100));
+    int nextId = 2;
+    for (int i = 0; i < 1000; ++i) {
+        heap.push(Task(nextId++, "urgent", urgent(rng)));
+    }
+
+    for (size_t pops = 1; pops <= limit; ++pops) {
+        if (heap.pop().getId() == 1) return pops;
+        heap.push(Task(nextId++, "urgent", urgent(rng)));
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const int intervals[] = {0, 100, 10000};
+
+    std::cout << "queue_size\taging_interval\tns_per_pop\n";
+    for (size_t queueSize : {10000u, 1000000u}) {
+        if (queueSize > maxSize) break;
+        for (int interval : intervals) {
+            std::cout << queueSize << "\t" << interval << "\t"
+                      << nsPerPop(interval, 100, queueSize, 1000000) << "\n";
+        }
+        std::cout << queueSize << "\tdistinct\t"
+                  << nsPerPop(0, 1000000000, queueSize, 1000000) << "\n";
+    }
+
+    std::cout << "\naging_interval\tpops_until_priority_100_runs\n";
+    const size_t limit = 10000000;
+    for (int interval : intervals) {
+        size_t pops = popsUntilLowPriorityRuns(interval, limit);
+        std::cout << interval << "\t";
+        if (pops == 0) {
+            std::cout << "starved (> " << limit << ")\n";
+        } else {
+            std::cout << pops << "\n";
+        }
+    }
+    return 0;
+}
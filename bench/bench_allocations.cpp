@@ -0,0 +1,137 @@
+// Counts global heap allocations per operation once the scheduler reaches a
+// steady state. Every engine runs a pop-then-push loop at a fixed queue
+// size, and each pushed task gets a fresh 40-byte description. Task text
+// comes from the description pool and index nodes from each engine's pool,
+// so these rows should read 0. The MinHeap rows add journal persistence and
+// logging. A plain add/pop pair still pays for the automatic backup after
+// every fifth pop. The batched row defers that backup to endBatch, as
+// scheduler --batch does; what remains there is amortized buffer growth and
+// the occasional journal compaction.
+//
+// Build: cmake -S . -B build && cmake --build build --target bench_allocations
+
+#include "binary_heap_queue.hpp"
+#include "bucket_queue.hpp"
+#include "dary_heap_queue.hpp"
+#include "pairing_heap_queue.hpp"
+#include "min_heap.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string_view>
+
+namespace {
+
+std::atomic<uint64_t> allocationCount{0};
+
+}  // namespace
+
+// Every operator new form funnels through these two
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Fills buffer with a 40-byte description unique to id
+std::string_view describe(char (&buffer)[48], int id) {
+    int length = std::snprintf(buffer, sizeof(buffer), "steady state task %022d", id);
+    return std::string_view(buffer, static_cast<size_t>(length));
+}
+
+struct Result {
+    double allocationsPerOp;
+    double nsPerOp;
+};
+
+template <typename Step>
+Result measure(size_t warmup, size_t ops, Step step) {
+    for (size_t i = 0; i < warmup; ++i) step();
+    uint64_t before = allocationCount.load();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ops; ++i) step();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t allocations = allocationCount.load() - before;
+    return {static_cast<double>(allocations) / ops,
+            std::chrono::duration<double, std::nano>(elapsed).count() / ops};
+}
+
+Result engineCycle(TaskQueue& queue, size_t queueSize, size_t ops) {
+    char buffer[48];
+    int nextId = 1;
+    for (size_t i = 0; i < queueSize; ++i, ++nextId) {
+        queue.push(Task(nextId, describe(buffer, nextId), nextId % 100 + 1));
+    }
+    return measure(ops, ops, [&] {
+        queue.pop();
+        queue.push(Task(nextId, describe(buffer, nextId), nextId % 100 + 1));
+        ++nextId;
+    });
+}
+
+Result schedulerCycle(size_t queueSize, size_t ops, bool batched) {
+    SchedulerConfig config;
+    config.persistence = PersistenceMode::Journal;
+    MinHeap heap(config);
+
+    char buffer[48];
+    int nextId = 1;
+    for (size_t i = 0; i < queueSize; ++i, ++nextId) {
+        heap.addTask(Task(nextId, describe(buffer, nextId), nextId % 100 + 1));
+    }
+    if (batched) heap.beginBatch();
+    Result result = measure(ops, ops, [&] {
+        heap.removeHighestPriorityTask();
+        heap.addTask(Task(nextId, describe(buffer, nextId), nextId % 100 + 1));
+        ++nextId;
+    });
+    if (batched) heap.endBatch();
+    heap.flushLogs();
+    return result;
+}
+
+void report(const char* name, const Result& result) {
+    std::printf("%s\t%.3f\t%.1f\n", name, result.allocationsPerOp, result.nsPerOp);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const size_t queueSize = 10000;
+
+    std::printf("workload\tallocations_per_op\tns_per_op\n");
+    {
+        BinaryHeapQueue queue;
+        report("binary_heap pop+push", engineCycle(queue, queueSize, ops));
+    }
+    {
+        BucketQueue queue;
+        report("bucket_queue pop+push", engineCycle(queue, queueSize, ops));
+    }
+    {
+        DaryHeapQueue<4> queue;
+        report("dary_heap_4 pop+push", engineCycle(queue, queueSize, ops));
+    }
+    {
+        DaryHeapQueue<8> queue;
+        report("dary_heap_8 pop+push", engineCycle(queue, queueSize, ops));
+    }
+    {
+        PairingHeapQueue queue;
+        report("pairing_heap pop+push", engineCycle(queue, queueSize, ops));
+    }
+
+    // The scheduler writes the journal, log and backups under data/. Unbatched
+    // pops back up the whole queue every fifth pop, so that row runs fewer ops.
+    report("min_heap journal pop+add", schedulerCycle(queueSize, ops / 1000 + 1, false));
+    report("min_heap journal batched", schedulerCycle(queueSize, ops / 10 + 1, true));
+    return 0;
+}
@@ -0,0 +1,166 @@
+// Throughput and stress harness for ConcurrentScheduler.
+//
+//   bench_concurrent            Mixed push/pop throughput at 1..N threads,
+//                               against a single mutex around one heap
+//   bench_concurrent --stress   Producers, consumers and updaters race; every
+//                               pushed ID must come out exactly once
+//
+// Build: g++ -O2 -std=c++17 -pthread -Iinclude bench/bench_concurrent.cpp $(ls src/*.cpp | grep -v src/scheduler.cpp)
+
+#include "binary_heap_queue.hpp"
+#include "concurrent_scheduler.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// The baseline this front end replaces: every operation behind one lock
+class GlobalLockQueue {
+private:
+    std::mutex mutex;
+    BinaryHeapQueue queue;
+
+public:
+    void addTask(const Task& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push(task);
+    }
+
+    bool tryRemoveHighestPriorityTask(Task& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) return false;
+        task = queue.pop();
+        return true;
+    }
+};
+
+template <typename Queue>
+double mopsPerSecond(Queue& queue, unsigned threads, size_t opsPerThread) {
+    // Prefill so pops rarely see an empty queue
+    const int prefill = 100000;
+    std::mt19937 rng(11);
+    for (int id = 1; id <= prefill; ++id) {
+        queue.addTask(Task(id, "bench", static_cast<int>(rng() % 100) + 1));
+    }
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::minstd_rand local(t + 1);
+            int nextId = prefill + 1 + static_cast<int>(t * opsPerThread);
+            Task task;
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (size_t i = 0; i < opsPerThread; i += 2) {
+                queue.addTask(Task(nextId++, "bench", static_cast<int>(local() % 100) + 1));
+                queue.tryRemoveHighestPriorityTask(task);
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return threads * opsPerThread / seconds / 1e6;
+}
+
+int stress() {
+    const unsigned producers = 4;
+    const unsigned consumers = 4;
+    const int tasksPerProducer = 200000;
+    const int total = producers * tasksPerProducer;
+
+    ConcurrentScheduler scheduler;
+    std::vector<std::atomic<int>> seen(total + 1);
+    std::atomic<int> removed{0};
+    std::atomic<bool> producing{true};
+    std::vector<std::thread> threads;
+
+    for (unsigned p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            std::minstd_rand rng(p + 1);
+            for (int i = 0; i < tasksPerProducer; ++i) {
+                int id = static_cast<int>(p) * tasksPerProducer + i + 1;
+                scheduler.addTask(Task(id, "stress", static_cast<int>(rng() % 100) + 1));
+            }
+        });
+    }
+    // Updater and canceller race with the consumers on random IDs
+    threads.emplace_back([&] {
+        std::minstd_rand rng(99);
+        while (producing.load()) {
+            int id = static_cast<int>(rng() % total) + 1;
+            try {
+                if (rng() % 4 == 0) {
+                    Task cancelled = scheduler.cancelTask(id);
+                    seen[cancelled.getId()].fetch_add(1);
+                    removed.fetch_add(1);
+                } else {
+                    scheduler.updateTaskPriority(id, static_cast<int>(rng() % 100) + 1);
+                }
+            } catch (const std::runtime_error&) {
+                // Not pushed yet or already gone
+            }
+        }
+    });
+    for (unsigned c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            Task task;
+            while (removed.load() < total) {
+                if (scheduler.tryRemoveHighestPriorityTask(task)) {
+                    seen[task.getId()].fetch_add(1);
+                    removed.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    for (unsigned p = 0; p < producers; ++p) threads[p].join();
+    producing.store(false);
+    for (size_t i = producers; i < threads.size(); ++i) threads[i].join();
+
+    for (int id = 1; id <= total; ++id) {
+        if (seen[id].load() != 1) {
+            std::cerr << "FAILED: task " << id << " removed " << seen[id].load() << " times\n";
+            return 1;
+        }
+    }
+    if (!scheduler.isEmpty()) {
+        std::cerr << "FAILED: " << scheduler.size() << " tasks left behind\n";
+        return 1;
+    }
+    std::cout << "stress ok: " << total << " tasks, each removed exactly once\n";
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--stress") == 0) {
+        return stress();
+    }
+
+    const size_t opsPerThread = 1000000;
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    std::cout << "threads\tglobal_lock_mops\tsharded_mops\n";
+    for (unsigned threads : threadCounts) {
+        GlobalLockQueue baseline;
+        ConcurrentScheduler sharded;
+        std::cout << threads << "\t" << mopsPerSecond(baseline, threads, opsPerThread) << "\t"
+                  << mopsPerSecond(sharded, threads, opsPerThread) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,48 @@
+// Measures TaskCsv::load on a large tasks file at increasing thread counts.
+// Pass the row count (default 10M) to size the generated file.
+//
+// Build: g++ -O2 -std=c++17 -pthread -Iinclude bench/bench_csv_load.cpp $(ls src/*.cpp | grep -v src/scheduler.cpp)
+
+#include "task_csv.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    const std::string path = "data/bench_csv_load.csv";
+    std::filesystem::create_directories("data");
+
+    {
+        std::vector<Task> tasks;
+        tasks.reserve(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            // Every tenth description needs quoting
+            std::string description = i % 10 == 0 ? "job, part " + std::to_string(i % 977)
+                                                   : "job part " + std::to_string(i % 977);
+            tasks.emplace_back(static_cast<int>(i + 1), std::move(description), static_cast<int>(i % 100) + 1);
+        }
+        TaskCsv::write(path, tasks);
+    }
+
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "rows\tthreads\tload_ms\n";
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        CsvLoadResult result = TaskCsv::load(path, threads);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (result.tasks.size() != rows || !result.errors.empty()) {
+            std::cerr << "Unexpected parse result: " << result.tasks.size() << " rows, "
+                      << result.errors.size() << " errors\n";
+            return 1;
+        }
+        std::cout << rows << "\t" << threads << "\t" << ms << "\n";
+    }
+
+    std::filesystem::remove(path);
+    return 0;
+}
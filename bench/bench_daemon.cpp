@@ -0,0 +1,105 @@
+// Load generator for the daemon: N client connections each pipeline
+// windows of ADD/POP pairs against one SchedulerDaemon over its Unix
+// socket. Reports requests per second and per-request latency (send of the
+// window to arrival of that request's answer) as connections grow, without
+// pipelining and with a window of 16. Journal persistence, syncWrites off.
+// Pass a maximum connection count to skip the larger runs.
+//
+// Build: cmake -S . -B build && cmake --build build --target bench_daemon
+
+#include "scheduler_client.hpp"
+#include "scheduler_daemon.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const char* SOCKET_PATH = "data/bench_daemon.sock";
+const size_t REQUESTS_PER_RUN = 200000;
+
+using Clock = std::chrono::steady_clock;
+
+double percentileUs(std::vector<double>& samples, double fraction) {
+    size_t index = static_cast<size_t>(fraction * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+void run(size_t connections, size_t depth, int& nextId) {
+    size_t windows = std::max<size_t>(1, REQUESTS_PER_RUN / (connections * depth));
+    std::vector<std::vector<double>> latencies(connections);
+    std::atomic<bool> go{false};
+    std::vector<std::thread> clients;
+    for (size_t c = 0; c < connections; ++c) {
+        int firstId = nextId + static_cast<int>(c * windows * depth);
+        clients.emplace_back([&, c, firstId] {
+            SchedulerClient client(SOCKET_PATH);
+            std::vector<double>& samples = latencies[c];
+            samples.reserve(windows * depth);
+            int id = firstId;
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+            for (size_t w = 0; w < windows; ++w) {
+                for (size_t i = 0; i < depth; ++i) {
+                    if ((w * depth + i) % 2 == 0) {
+                        client.queueAdd(Task(id, "bench task", id % 100 + 1));
+                        ++id;
+                    } else {
+                        client.queuePop();
+                    }
+                }
+                auto sent = Clock::now();
+                client.send();
+                while (client.outstanding() > 0) {
+                    client.readReply();
+                    samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - sent).count());
+                }
+            }
+        });
+    }
+    nextId += static_cast<int>(connections * windows * depth);
+
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& client : clients) client.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> all;
+    for (auto& samples : latencies) all.insert(all.end(), samples.begin(), samples.end());
+    std::cout << connections << "\t" << depth << "\t" << static_cast<long long>(all.size() / seconds)
+              << "\t" << percentileUs(all, 0.50) << "\t" << percentileUs(all, 0.99)
+              << "\t" << percentileUs(all, 0.999) << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t maxConnections = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+
+    SchedulerConfig config;
+    config.syncWrites = false;
+    MinHeap heap(config);
+    DaemonConfig daemonConfig;
+    daemonConfig.socketPath = SOCKET_PATH;
+    SchedulerDaemon daemon(heap, daemonConfig);
+    daemon.listen();
+    std::thread server([&] { daemon.run(); });
+
+    std::cout << "connections\tdepth\treq_per_s\tp50_us\tp99_us\tp999_us\n";
+    int nextId = 1;
+    for (size_t connections : {1u, 4u, 16u, 64u}) {
+        if (connections > maxConnections) break;
+        for (size_t depth : {1u, 16u}) {
+            run(connections, depth, nextId);
+        }
+    }
+
+    daemon.stop();
+    server.join();
+    return 0;
+}
@@ -0,0 +1,64 @@
+// Compares heap layouts on multi-million-entry queues: the Task-array binary
+// heap against the key/payload d-ary heap at arities 2, 4 and 8, and the
+// 4-ary heap under its other compile-time policies: max-first ordering and
+// FIFO tie-breaking. Priorities span a wide range so the heap is deep and
+// pops walk the full height.
+// Pass a maximum queue size to skip the larger runs on small machines.
+//
+// Build: g++ -O2 -std=c++17 -pthread -Iinclude bench/bench_dary_heap.cpp $(ls src/*.cpp | grep -v src/scheduler.cpp)
+
+#include "binary_heap_queue.hpp"
+#include "dary_heap_queue.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+volatile long long sink;  // Keeps the popped values observable
+
+void run(const char* layout, TaskQueue& queue, const std::vector<int>& priorities) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < priorities.size(); ++i) {
+        queue.push(Task(static_cast<int>(i + 1), "bench", priorities[i]));
+    }
+    auto pushed = std::chrono::steady_clock::now();
+
+    long long checksum = 0;
+    while (!queue.empty()) {
+        checksum += queue.pop().getPriority();
+    }
+    auto popped = std::chrono::steady_clock::now();
+    sink = checksum;
+
+    double n = static_cast<double>(priorities.size());
+    std::cout << priorities.size() << "\t" << layout << "\t"
+              << std::chrono::duration<double, std::nano>(pushed - start).count() / n << "\t"
+              << std::chrono::duration<double, std::nano>(popped - pushed).count() / n << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+
+    std::cout << "queue_size\tlayout\tns_per_push\tns_per_pop\n";
+    for (size_t queueSize : {100000u, 1000000u, 4000000u}) {
+        if (queueSize > maxSize) break;
+
+        std::mt19937 rng(99);
+        std::uniform_int_distribution<int> priorityDist(0, 1000000000);
+        std::vector<int> priorities(queueSize);
+        for (auto& p : priorities) p = priorityDist(rng);
+
+        { BinaryHeapQueue q; run("binary_tasks", q, priorities); }
+        { DaryHeapQueue<2> q; run("dary2_keys", q, priorities); }
+        { DaryHeapQueue<4> q; run("dary4_keys", q, priorities); }
+        { DaryHeapQueue<8> q; run("dary8_keys", q, priorities); }
+        { DaryHeapQueue<4, MaxFirst> q; run("dary4_max", q, priorities); }
+        { DaryHeapQueue<4, MinFirst, FifoTieBreak> q; run("dary4_fifo", q, priorities); }
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+// Compares the binary heap, bucket queue and pairing heap engines on a
+// push-all then pop-all workload with priorities drawn from the scheduler's
+// 1-100 range.
+// Pass a maximum queue size to skip the larger runs on small machines.
+//
+// Build: g++ -O2 -std=c++17 -pthread -Iinclude bench/bench_engines.cpp $(ls src/*.cpp | grep -v src/scheduler.cpp)
+
+#include "binary_heap_queue.hpp"
+#include "bucket_queue.hpp"
+#include "pairing_heap_queue.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+volatile long long sink;  // Keeps the popped values observable
+
+struct Result {
+    double nsPerPush;
+    double nsPerPop;
+};
+
+Result run(TaskQueue& queue, const std::vector<int>& priorities) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < priorities.size(); ++i) {
+        queue.push(Task(static_cast<int>(i + 1), "bench", priorities[i]));
+    }
+    auto pushed = std::chrono::steady_clock::now();
+
+    long long checksum = 0;
+    while (!queue.empty()) {
+        checksum += queue.pop().getPriority();
+    }
+    auto popped = std::chrono::steady_clock::now();
+    sink = checksum;
+
+    double n = static_cast<double>(priorities.size());
+    return {std::chrono::duration<double, std::nano>(pushed - start).count() / n,
+            std::chrono::duration<double, std::nano>(popped - pushed).count() / n};
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::cout << "queue_size\tengine\tns_per_push\tns_per_pop\n";
+    for (size_t queueSize : {1000u, 1000000u, 10000000u}) {
+        if (queueSize > maxSize) break;
+
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> priorityDist(1, 100);
+        std::vector<int> priorities(queueSize);
+        for (auto& p : priorities) p = priorityDist(rng);
+
+        {
+            BinaryHeapQueue heap;
+            Result r = run(heap, priorities);
+            std::cout << queueSize << "\tbinary_heap\t" << r.nsPerPush << "\t" << r.nsPerPop << "\n";
+        }
+        {
+            BucketQueue buckets(1, 100);
+            Result r = run(buckets, priorities);
+            std::cout << queueSize << "\tbucket_queue\t" << r.nsPerPush << "\t" << r.nsPerPop << "\n";
+        }
+        {
+            PairingHeapQueue pairing;
+            Result r = run(pairing, priorities);
+            std::cout << queueSize << "\tpairing_heap\t" << r.nsPerPush << "\t" << r.nsPerPop << "\n";
+        }
+    }
+    return 0;
+}
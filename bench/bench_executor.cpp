@@ -0,0 +1,48 @@
+// Measures TaskExecutor throughput for very short tasks at 1..N workers and
+// checks that every submitted callable ran exactly once.
+//
+// Build: g++ -O2 -std=c++17 -pthread -Iinclude bench/bench_executor.cpp $(ls src/*.cpp | grep -v src/scheduler.cpp)
+
+#include "task_executor.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main() {
+    const int tasks = 500000;
+    unsigned maxWorkers = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<unsigned> workerCounts;
+    for (unsigned workers = 1; workers < maxWorkers; workers *= 2) workerCounts.push_back(workers);
+    workerCounts.push_back(maxWorkers);
+
+    std::cout << "workers\ttasks_per_sec\n";
+    for (unsigned workers : workerCounts) {
+        ConcurrentScheduler scheduler;
+        ExecutorConfig config;
+        config.workers = workers;
+        std::vector<std::atomic<int>> runs(tasks + 1);
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            TaskExecutor executor(scheduler, nullptr, config);
+            for (int id = 1; id <= tasks; ++id) {
+                executor.submit(Task(id, "short", id % 100 + 1), [&runs, id] { runs[id].fetch_add(1); });
+            }
+            executor.waitIdle();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (int id = 1; id <= tasks; ++id) {
+            if (runs[id].load() != 1) {
+                std::cerr << "Task " << id << " ran " << runs[id].load() << " times\n";
+                return 1;
+            }
+        }
+        std::cout << workers << "\t" << tasks / seconds << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+// Measures combining two queues of n tasks each, then draining the result.
+// "pop_push" is what callers did before TaskQueue::merge: pop every task
+// out of one queue and push it into the other. The merge rows use
+// TaskQueue::merge, which is a bottom-up rebuild for the array heaps and a
+// meld for the pairing heap. A second table times random decrease-key
+// updates by task ID on a binary heap and the pairing heap, and by handle on
+// the pairing heap, which skips the ID lookup.
+// Pass a maximum queue size to skip the larger runs on small machines.
+//
+// Build: cmake -S . -B build && cmake --build build --target bench_meld
+
+#include "binary_heap_queue.hpp"
+#include "dary_heap_queue.hpp"
+#include "pairing_heap_queue.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+volatile long long sink;  // Keeps the popped values observable
+
+using Clock = std::chrono::steady_clock;
+
+void fill(TaskQueue& queue, const std::vector<int>& priorities, int firstId) {
+    for (size_t i = 0; i < priorities.size(); ++i) {
+        queue.push(Task(firstId + static_cast<int>(i), "bench", priorities[i]));
+    }
+}
+
+template <typename Queue>
+void runMerge(const char* name, const std::vector<int>& priorities, bool popPush) {
+    Queue target;
+    Queue source;
+    fill(target, priorities, 1);
+    fill(source, priorities, static_cast<int>(priorities.size()) + 1);
+
+    auto start = Clock::now();
+    if (popPush) {
+        while (!source.empty()) {
+            target.push(source.pop());
+        }
+    } else {
+        target.merge(source);
+    }
+    auto merged = Clock::now();
+
+    long long checksum = 0;
+    size_t count = target.size();
+    while (!target.empty()) {
+        checksum += target.pop().getPriority();
+    }
+    auto drained = Clock::now();
+    sink = checksum;
+
+    std::cout << priorities.size() << "\t" << name << "\t"
+              << std::chrono::duration<double, std::micro>(merged - start).count() << "\t"
+              << std::chrono::duration<double, std::nano>(drained - merged).count() / count << "\n";
+}
+
+template <typename Queue>
+void runDecrease(const char* name, const std::vector<int>& priorities, std::mt19937& rng,
+                 bool byHandle = false) {
+    Queue queue;
+    fill(queue, priorities, 1);
+
+    // Each update lowers a random task's priority a little, as aging would
+    std::vector<int> current = priorities;
+    std::uniform_int_distribution<int> idDist(1, static_cast<int>(priorities.size()));
+    std::uniform_int_distribution<int> stepDist(1, 1000);
+    std::vector<std::pair<int, int>> updates(200000);
+    for (auto& update : updates) {
+        int id = idDist(rng);
+        current[id - 1] -= stepDist(rng);
+        update = {id, current[id - 1]};
+    }
+
+    std::vector<PairingHeapQueue::Handle> handles;
+    if constexpr (std::is_same_v<Queue, PairingHeapQueue>) {
+        if (byHandle) {
+            handles.reserve(updates.size());
+            for (const auto& update : updates) handles.push_back(queue.handleOf(update.first));
+        }
+    }
+
+    auto start = Clock::now();
+    if constexpr (std::is_same_v<Queue, PairingHeapQueue>) {
+        if (byHandle) {
+            for (size_t i = 0; i < updates.size(); ++i) {
+                queue.decreaseKey(handles[i], updates[i].second);
+            }
+        }
+    }
+    if (!byHandle) {
+        for (const auto& update : updates) {
+            queue.updatePriority(update.first, update.second);
+        }
+    }
+    auto elapsed = Clock::now() - start;
+    std::cout << priorities.size() << "\t" << name << "\t"
+              << std::chrono::duration<double, std::nano>(elapsed).count() / updates.size() << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::mt19937 rng(2024);
+
+    std::cout << "queue_size\tmethod\tmerge_us\tns_per_pop_after\n";
+    for (size_t queueSize : {10000u, 100000u, 1000000u}) {
+        if (queueSize > maxSize) break;
+        std::uniform_int_distribution<int> priorityDist(1, 1000000);
+        std::vector<int> priorities(queueSize);
+        for (auto& p : priorities) p = priorityDist(rng);
+
+        runMerge<BinaryHeapQueue>("binary_pop_push", priorities, true);
+        runMerge<BinaryHeapQueue>("binary_merge", priorities, false);
+        runMerge<DaryHeapQueue<4>>("dary4_merge", priorities, false);
+        runMerge<PairingHeapQueue>("pairing_meld", priorities, false);
+    }
+
+    std::cout << "\nqueue_size\tengine\tns_per_decrease\n";
+    for (size_t queueSize : {10000u, 100000u, 1000000u}) {
+        if (queueSize > maxSize) break;
+        std::uniform_int_distribution<int> priorityDist(1, 1000000);
+        std::vector<int> priorities(queueSize);
+        for (auto& p : priorities) p = priorityDist(rng);
+
+        runDecrease<BinaryHeapQueue>("binary_heap", priorities, rng);
+        runDecrease<PairingHeapQueue>("pairing_heap", priorities, rng);
+        runDecrease<PairingHeapQueue>("pairing_handle", priorities, rng, true);
+    }
+    return 0;
+}
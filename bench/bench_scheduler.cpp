@@ -0,0 +1,310 @@
+// Regression suite for the scheduler and its I/O paths. Every benchmark runs
+// per queue size and priority distribution and reports ns/op, p50 and p99.
+// Results are written as JSON so runs from different releases can be diffed.
+//
+// Usage: bench_scheduler [--out results.json] [--sizes 1000,10000]
+//                        [--distributions uniform,skewed,constant] [--quick]
+//
+// The suite runs inside a scratch directory under the system temp dir, so
+// it never touches a real data/ directory.
+//
+// Build: cmake -S . -B build && cmake --build build --target bench_scheduler
+
+#include "min_heap.hpp"
+#include "file_manager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    std::string benchmark;
+    size_t queueSize;
+    std::string distribution;
+    size_t iterations;
+    double nsPerOp;
+    double p50;
+    double p99;
+};
+
+// Per-operation samples in nanoseconds plus the wall time of the whole run
+struct Samples {
+    std::vector<double> ns;
+    double totalNs = 0;
+
+    template <typename Op>
+    void time(Op&& op) {
+        auto start = Clock::now();
+        op();
+        double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        ns.push_back(elapsed);
+        totalNs += elapsed;
+    }
+};
+
+double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) return 0;
+    size_t rank = static_cast<size_t>(fraction * (values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+int drawPriority(const std::string& distribution, std::mt19937& rng) {
+    if (distribution == "constant") return 50;
+    if (distribution == "skewed") {
+        // Most tasks cluster at the urgent end, like a real backlog
+        static std::geometric_distribution<int> skewed(0.08);
+        return std::min(100, 1 + skewed(rng));
+    }
+    static std::uniform_int_distribution<int> uniform(1, 100);
+    return uniform(rng);
+}
+
+std::vector<Task> makeTasks(size_t count, const std::string& distribution, std::mt19937& rng) {
+    std::vector<Task> tasks;
+    tasks.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        tasks.emplace_back(static_cast<int>(i + 1), "bench task " + std::to_string(i),
+                           drawPriority(distribution, rng));
+    }
+    return tasks;
+}
+
+SchedulerConfig configFor(PersistenceMode mode) {
+    SchedulerConfig config;
+    config.persistence = mode;
+    return config;
+}
+
+// Fresh data/ directory for every case so earlier runs do not leak state
+void resetData() {
+    fs::remove_all("data");
+}
+
+class Suite {
+private:
+    std::vector<Result> results;
+    size_t queueSize = 0;
+    std::string distribution;
+    std::mt19937 rng{42};
+
+    void record(const std::string& benchmark, const Samples& samples) {
+        Result result{benchmark, queueSize, distribution, samples.ns.size(),
+                      samples.ns.empty() ? 0 : samples.totalNs / samples.ns.size(),
+                      percentile(samples.ns, 0.50), percentile(samples.ns, 0.99)};
+        std::cout << result.benchmark << "\t" << result.queueSize << "\t" << result.distribution << "\t"
+                  << result.iterations << "\t" << result.nsPerOp << "\t" << result.p50 << "\t"
+                  << result.p99 << std::endl;
+        results.push_back(result);
+    }
+
+    // Timed operations per case: enough to be stable, bounded on big queues
+    size_t opCount() const { return std::min<size_t>(queueSize, 100000); }
+    size_t fileRepeats() const { return queueSize <= 10000 ? 20 : 5; }
+
+    void benchAdd() {
+        std::vector<Task> tasks = makeTasks(queueSize, distribution, rng);
+        MinHeap heap(configFor(PersistenceMode::Journal));
+        Samples samples;
+        for (const auto& task : tasks) {
+            samples.time([&] { heap.addTask(task); });
+        }
+        record("heap_add_task", samples);
+    }
+
+    void benchRemove(PersistenceMode mode, const std::string& name, size_t pops) {
+        MinHeap heap(configFor(mode));
+        heap.addTasks(makeTasks(queueSize, distribution, rng));
+        heap.saveToFile();
+        Samples samples;
+        for (size_t i = 0; i < pops && !heap.isEmpty(); ++i) {
+            samples.time([&] { heap.removeHighestPriorityTask(); });
+        }
+        record(name, samples);
+    }
+
+    void benchUpdate() {
+        MinHeap heap(configFor(PersistenceMode::Journal));
+        heap.addTasks(makeTasks(queueSize, distribution, rng));
+        std::uniform_int_distribution<int> idDist(1, static_cast<int>(queueSize));
+        Samples samples;
+        for (size_t i = 0; i < opCount(); ++i) {
+            int id = idDist(rng);
+            int priority = drawPriority(distribution, rng);
+            samples.time([&] { heap.updateTaskPriority(id, priority); });
+        }
+        record("heap_update_priority", samples);
+    }
+
+    void benchLoadFromFile() {
+        {
+            MinHeap heap(configFor(PersistenceMode::Journal));
+            heap.addTasks(makeTasks(queueSize, distribution, rng));
+            heap.saveToFile();
+        }
+        Samples samples;
+        for (size_t i = 0; i < fileRepeats(); ++i) {
+            MinHeap heap(configFor(PersistenceMode::Journal));
+            samples.time([&] { heap.loadFromFile(); });
+        }
+        record("heap_load_from_file", samples);
+    }
+
+    void benchFileManager() {
+        std::vector<Task> tasks = makeTasks(queueSize, distribution, rng);
+        std::vector<CompletedTask> completed;
+        for (auto& task : makeTasks(std::min<size_t>(queueSize, 10), distribution, rng)) {
+            completed.push_back({std::move(task), 0});
+        }
+        FileManager fileManager;
+
+        Samples save;
+        for (size_t i = 0; i < fileRepeats(); ++i) {
+            save.time([&] { fileManager.saveTasks(tasks); });
+        }
+        record("file_save_tasks", save);
+
+        Samples load;
+        for (size_t i = 0; i < fileRepeats(); ++i) {
+            load.time([&] { fileManager.loadTasks(); });
+        }
+        record("file_load_tasks", load);
+
+        Samples backup;
+        for (size_t i = 0; i < fileRepeats(); ++i) {
+            backup.time([&] { fileManager.createBackup(tasks); });
+        }
+        record("file_create_backup", backup);
+
+        Samples report;
+        for (size_t i = 0; i < fileRepeats(); ++i) {
+            report.time([&] {
+                fileManager.generateReport(tasks, completed);
+                fileManager.waitForReport();
+            });
+        }
+        record("file_generate_report", report);
+    }
+
+public:
+    void run(size_t size, const std::string& dist) {
+        queueSize = size;
+        distribution = dist;
+
+        resetData();
+        benchAdd();
+        resetData();
+        benchRemove(PersistenceMode::Journal, "heap_remove_top_journal", opCount());
+        resetData();
+        // Snapshot mode rewrites the whole file per pop, so keep the count small
+        benchRemove(PersistenceMode::Snapshot, "heap_remove_top_snapshot", std::min<size_t>(queueSize, 100));
+        resetData();
+        benchUpdate();
+        resetData();
+        benchLoadFromFile();
+        resetData();
+        benchFileManager();
+        resetData();
+    }
+
+    bool writeJson(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out.is_open()) return false;
+
+        out << "{\n  \"suite\": \"bench_scheduler\",\n  \"timestamp\": " << std::time(nullptr)
+            << ",\n  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            out << "    {\"benchmark\": \"" << r.benchmark << "\", \"queue_size\": " << r.queueSize
+                << ", \"distribution\": \"" << r.distribution << "\", \"iterations\": " << r.iterations
+                << ", \"ns_per_op\": " << r.nsPerOp << ", \"p50_ns\": " << r.p50
+                << ", \"p99_ns\": " << r.p99 << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+        return out.good();
+    }
+};
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string outPath = "bench_scheduler.json";
+    std::vector<size_t> sizes = {1000, 10000, 100000};
+    std::vector<std::string> distributions = {"uniform", "skewed", "constant"};
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            sizes = {1000};
+            distributions = {"uniform"};
+        } else if (arg == "--out" && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (arg == "--sizes" && i + 1 < argc) {
+            sizes.clear();
+            for (const auto& size : splitList(argv[++i])) {
+                sizes.push_back(std::strtoull(size.c_str(), nullptr, 10));
+            }
+        } else if (arg == "--distributions" && i + 1 < argc) {
+            distributions = splitList(argv[++i]);
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    for (const auto& distribution : distributions) {
+        if (distribution != "uniform" && distribution != "skewed" && distribution != "constant") {
+            std::cerr << "Unknown distribution: " << distribution << "\n";
+            return 2;
+        }
+    }
+
+    fs::path resultsFile = fs::absolute(outPath);
+    fs::path original = fs::current_path();
+    fs::path scratch = fs::temp_directory_path() / ("bench_scheduler_" + std::to_string(::getpid()));
+    fs::create_directories(scratch);
+    fs::current_path(scratch);
+
+    std::cout << "benchmark\tqueue_size\tdistribution\titerations\tns_per_op\tp50_ns\tp99_ns\n";
+    Suite suite;
+    for (size_t size : sizes) {
+        if (size == 0) continue;
+        for (const auto& distribution : distributions) {
+            suite.run(size, distribution);
+        }
+    }
+
+    fs::current_path(original);
+    fs::remove_all(scratch);
+
+    if (!suite.writeJson(resultsFile.string())) {
+        std::cerr << "Could not write " << resultsFile << "\n";
+        return 1;
+    }
+    std::cout << "Results written to " << resultsFile.string() << "\n";
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Compares the CSV text format with the binary snapshot format for writing,
+// loading and on-disk size. Pass the row count (default 1M).
+//
+// Build: g++ -O2 -std=c++17 -pthread -Iinclude bench/bench_snapshot.cpp $(ls src/*.cpp | grep -v src/scheduler.cpp)
+
+#include "task_csv.hpp"
+#include "task_snapshot.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    fs::create_directories("data");
+    const std::string csvPath = "data/bench_snapshot.csv";
+    const std::string snapPath = "data/bench_snapshot.snap";
+
+    std::vector<Task> tasks;
+    tasks.reserve(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        tasks.emplace_back(static_cast<int>(i + 1), "nightly job " + std::to_string(i % 5000),
+                           static_cast<int>(i % 100) + 1);
+    }
+
+    std::cout << "format\trows\twrite_ms\tload_ms\tbytes\n";
+
+    auto start = std::chrono::steady_clock::now();
+    TaskCsv::write(csvPath, tasks);
+    double csvWrite = msSince(start);
+    start = std::chrono::steady_clock::now();
+    size_t csvRows = TaskCsv::load(csvPath).tasks.size();
+    double csvLoad = msSince(start);
+    std::cout << "csv\t" << csvRows << "\t" << csvWrite << "\t" << csvLoad << "\t"
+              << fs::file_size(csvPath) << "\n";
+
+    start = std::chrono::steady_clock::now();
+    TaskSnapshot::write(snapPath, tasks);
+    double snapWrite = msSince(start);
+    start = std::chrono::steady_clock::now();
+    size_t snapRows = TaskSnapshot::load(snapPath).tasks.size();
+    double snapLoad = msSince(start);
+    std::cout << "binary\t" << snapRows << "\t" << snapWrite << "\t" << snapLoad << "\t"
+              << fs::file_size(snapPath) << "\n";
+
+    fs::remove(csvPath);
+    fs::remove(snapPath);
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Measures cold-start cost: parsing tasks.csv, then building the queue
+// either with one addTask per row or with the bottom-up addTasks batch.
+// Pass a maximum row count to skip the larger runs on small machines.
+//
+// Build: g++ -O2 -std=c++17 -pthread -Iinclude bench/bench_startup.cpp $(ls src/*.cpp | grep -v src/scheduler.cpp)
+
+#include "min_heap.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t maxRows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    SchedulerConfig config;
+    config.persistence = PersistenceMode::Snapshot;  // Keep addTask free of journal writes
+
+    std::cout << "rows\tparse_ms\tadd_each_ms\tadd_batch_ms\tload_from_file_ms\n";
+    for (size_t rows : {10000u, 100000u, 1000000u}) {
+        if (rows > maxRows) break;
+
+        std::mt19937 rng(5);
+        std::uniform_int_distribution<int> priorityDist(1, 100);
+        std::vector<Task> tasks;
+        tasks.reserve(rows);
+        for (size_t i = 0; i < rows; ++i) {
+            tasks.emplace_back(static_cast<int>(i + 1), "startup bench task", priorityDist(rng));
+        }
+
+        FileManager fileManager;
+        fileManager.saveTasks(tasks);
+
+        auto start = std::chrono::steady_clock::now();
+        auto parsed = fileManager.loadTasks();
+        double parseMs = msSince(start);
+
+        double addEachMs;
+        {
+            MinHeap heap(config);
+            start = std::chrono::steady_clock::now();
+            for (const auto& task : parsed) {
+                heap.addTask(task);
+            }
+            addEachMs = msSince(start);
+        }
+
+        double addBatchMs;
+        {
+            MinHeap heap(config);
+            std::vector<Task> batch = parsed;
+            start = std::chrono::steady_clock::now();
+            heap.addTasks(std::move(batch));
+            addBatchMs = msSince(start);
+        }
+
+        double loadMs;
+        {
+            MinHeap heap(config);
+            start = std::chrono::steady_clock::now();
+            heap.loadFromFile();
+            loadMs = msSince(start);
+        }
+
+        std::cout << rows << "\t" << parseMs << "\t" << addEachMs << "\t"
+                  << addBatchMs << "\t" << loadMs << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,46 @@
+// Measures MinHeap::updateTaskPriority latency as the queue grows.
+// With the ID -> slot index the cost should track log(n), not n.
+//
+// Build: g++ -O2 -std=c++17 -pthread -Iinclude bench/bench_update_priority.cpp $(ls src/*.cpp | grep -v src/scheduler.cpp)
+
+#include "min_heap.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+double nsPerUpdate(size_t queueSize, size_t updates, std::mt19937& rng) {
+    MinHeap heap;
+    std::uniform_int_distribution<int> priorityDist(1, 100);
+    for (size_t i = 0; i < queueSize; ++i) {
+        heap.addTask(Task(static_cast<int>(i + 1), "bench", priorityDist(rng)));
+    }
+
+    std::uniform_int_distribution<int> idDist(1, static_cast<int>(queueSize));
+    std::vector<std::pair<int, int>> ops(updates);
+    for (auto& op : ops) {
+        op = {idDist(rng), priorityDist(rng)};
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& op : ops) {
+        heap.updateTaskPriority(op.first, op.second);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / updates;
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937 rng(42);
+    const size_t updates = 200000;
+
+    std::cout << "queue_size\tns_per_update\n";
+    for (size_t queueSize : {1000u, 10000u, 100000u, 1000000u}) {
+        std::cout << queueSize << "\t" << nsPerUpdate(queueSize, updates, rng) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#ifndef ASYNC_LOGGER_HPP
+#define ASYNC_LOGGER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "task_text.hpp"
+
+enum class OverflowPolicy {
+    Block,      // Wait for the writer to free a slot
+    Drop,       // Discard the record silently
+    CountDrops  // Discard the record and note the count in the log
+};
+
+struct LoggerConfig {
+    size_t queueCapacity = 8192;                // Rounded up to a power of two
+    size_t batchSize = 256;                     // Records formatted per write
+    size_t maxFileBytes = 16 * 1024 * 1024;     // Rotate once the log passes this
+    int maxRotatedFiles = 3;                    // Keep scheduler_log.txt.1 .. .N
+    OverflowPolicy overflow = OverflowPolicy::Block;
+};
+
+struct LogRecord {
+    std::chrono::system_clock::time_point time;
+    std::string action;
+    bool hasTask = false;
+    int taskId = 0;
+    int priority = 0;
+    TaskText description;
+};
+
+// Producers push records into a bounded lock-free ring; a single writer
+// thread formats them and appends them to the log file in batches.
+class AsyncLogger {
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    std::string path;
+    LoggerConfig config;
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) size_t dequeuePos = 0;  // Only touched by the writer
+    alignas(64) std::atomic<size_t> writtenCount{0};
+    std::atomic<uint64_t> droppedCount{0};
+    uint64_t reportedDrops = 0;
+
+    std::atomic<bool> running{true};
+    std::mutex wakeMutex;
+    std::condition_variable wakeWriter;
+    std::condition_variable batchWritten;
+
+    // Writer-thread state
+    std::ofstream out;
+    size_t fileBytes = 0;
+    std::time_t cachedSecond = 0;
+    std::string cachedTimestamp;
+
+    std::thread writer;
+
+    bool tryPush(LogRecord& record);
+    bool tryPop(LogRecord& record);
+    void writerLoop();
+    void appendFormatted(std::string& buffer, const LogRecord& record);
+    const std::string& timestampFor(std::chrono::system_clock::time_point time);
+    void openLog();
+    void rotate();
+
+public:
+    explicit AsyncLogger(const std::string& logPath, const LoggerConfig& loggerConfig = LoggerConfig());
+    ~AsyncLogger();
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    void log(LogRecord record);
+    void flush();
+    uint64_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+};
+
+#endif
\ No newline at end of file
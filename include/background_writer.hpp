@@ -0,0 +1,42 @@
+#ifndef BACKGROUND_WRITER_HPP
+#define BACKGROUND_WRITER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// One worker thread that runs file jobs in submission order. Snapshot and
+// backup writes are serialized and synced here instead of on the
+// scheduler's thread. FIFO order means a backup delta is never written
+// before the base it extends. Each job holds a copy of the tasks, so at most
+// maxQueued jobs wait at once; submit blocks for room beyond that. The
+// destructor finishes every queued job.
+class BackgroundWriter {
+private:
+    std::mutex mutex;
+    std::condition_variable jobReady;
+    std::condition_variable drained;
+    std::condition_variable roomFree;
+    std::deque<std::function<void()>> jobs;
+    bool running = true;
+    bool busy = false;  // A job is executing outside the lock
+    size_t maxQueued;
+    std::thread worker;
+
+    void run();
+
+public:
+    explicit BackgroundWriter(size_t maxQueuedJobs = 4);
+    ~BackgroundWriter();
+
+    BackgroundWriter(const BackgroundWriter&) = delete;
+    BackgroundWriter& operator=(const BackgroundWriter&) = delete;
+
+    void submit(std::function<void()> job);
+    // Blocks until every job submitted so far has finished
+    void wait();
+};
+
+#endif
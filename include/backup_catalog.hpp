@@ -0,0 +1,76 @@
+#ifndef BACKUP_CATALOG_HPP
+#define BACKUP_CATALOG_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+struct BackupEntry {
+    std::string path;
+    int64_t createdMs = 0;    // ms since the epoch of the state it holds
+    uint64_t bytes = 0;
+    uint64_t taskCount = 0;   // Tasks in a full backup, records in a delta
+    uint64_t checksum = 0;    // FNV-1a over the file contents
+
+    bool isDelta() const;
+};
+
+// Which full backups survive thinning. The newest keepLast always stay;
+// beyond those the newest backup of each of the last keepHourly hours and
+// keepDaily days (UTC) is kept. keepLast == 0 keeps everything.
+struct BackupRetention {
+    size_t keepLast = 50;
+    size_t keepHourly = 24;
+    size_t keepDaily = 30;
+};
+
+// Index of the backup directory kept in an append-only manifest, so listing
+// restore points and finding the latest one never scan the directory. Each
+// line adds or replaces an entry ("B,ms,file,bytes,tasks,checksum") or
+// drops one ("R,file"). The manifest is rewritten whole once dropped lines
+// outnumber live ones. A torn last line from a crash is ignored on load.
+// Safe to use from several threads.
+class BackupCatalog {
+private:
+    std::string directory;
+    std::string manifestPath;
+    mutable std::mutex mutex;
+    std::vector<BackupEntry> entries;        // Oldest first
+    std::unordered_set<std::string> paths;
+    std::ofstream out;
+    size_t staleRecords = 0;                 // Manifest lines no longer describing an entry
+
+    void appendLine(const std::string& line);
+    void rewriteIfStale();
+    static std::string formatEntry(const BackupEntry& entry);
+
+public:
+    explicit BackupCatalog(const std::string& backupDirectory);
+
+    // Reads the manifest; false when there is none yet
+    bool load();
+    // Replaces the catalog with entries found some other way and writes a
+    // fresh manifest for them
+    void rebuild(std::vector<BackupEntry> found);
+
+    void add(BackupEntry entry);  // Replaces an entry for the same path
+    void remove(const std::string& path);
+    bool contains(const std::string& path) const;
+    bool find(const std::string& path, BackupEntry& entry) const;
+    bool latest(BackupEntry& entry) const;
+    std::vector<BackupEntry> list() const;  // Newest first
+    size_t size() const;
+
+    // Full backups older than protectFromMs that the policy drops
+    std::vector<std::string> expired(const BackupRetention& retention, int64_t protectFromMs) const;
+
+    static uint64_t checksum(std::string_view data);
+    // Checksum and size of a file on disk; false if it cannot be read
+    static bool checksumFile(const std::string& path, uint64_t& checksum, uint64_t& bytes);
+};
+
+#endif
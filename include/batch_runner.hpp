@@ -0,0 +1,85 @@
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include "min_heap.hpp"
+
+struct BatchConfig {
+    size_t maxCommands = 4096;  // Commands per batch before persisting
+    bool allowWait = false;     // POPWAIT parks on an empty queue; needs another producer
+};
+
+// Non-interactive front end. Reads one command per line:
+//
+//   ADD <id> <priority> <description>    -> OK
+//   POP [count]                          -> TASK <id> <priority> <description> per task, then
+//                                           EMPTY if the queue ran out
+//   POPWAIT <timeout ms> [count]         -> as POP, but an empty queue waits up to the timeout
+//                                           for a task when allowWait is set
+//   DRAIN <priority>                     -> TASK ... per task at or below priority, then DRAINED <n>
+//   UPDATE <id> <priority>               -> OK
+//   CANCEL <id>                          -> OK
+//   SAVE | BACKUP                        -> OK
+//   STATS                                -> STATS <op>=<count>,<p50 ns>,<p99 ns> ...
+//
+// Blank lines and lines starting with '#' are skipped. Failures answer
+// "ERR <line> <message>", and passed deadlines appear as
+// "DEADLINE <id> <priority> <description>". Input is read in large blocks.
+// The complete lines of a block, up to maxCommands, form one batch: runs of
+// ADDs go to the heap as a single addTasks, and snapshots, journal writes
+// and responses are flushed once per batch.
+//
+// The daemon drives one runner per connection through runCommands instead
+// of run, bracketing each round of connections with one heap batch.
+class BatchRunner {
+private:
+    MinHeap& heap;
+    BatchConfig config;
+    std::string out;
+    std::vector<Task> pendingAdds;
+    std::unordered_set<int> pendingIds;
+    size_t lineNumber = 0;
+    size_t failures = 0;
+    bool parked = false;  // A POPWAIT is waiting for a task
+    size_t parkedCount = 0;
+    std::chrono::steady_clock::time_point parkedUntil;
+
+    void execute(std::string_view line);
+    void queueAdd(std::string_view args);
+    void flushAdds();
+    void pop(std::string_view args);
+    void popWait(std::string_view args);
+    void answerPop(const std::vector<Task>& executed, size_t count);
+    void drain(std::string_view args);
+    void stats();
+    void fail(const std::string& message);
+    void appendTask(const char* tag, const Task& task);
+    void runBatch(const std::vector<std::string_view>& lines);
+    bool writeOut(int fd);
+
+public:
+    explicit BatchRunner(MinHeap& scheduler, const BatchConfig& batchConfig = BatchConfig());
+
+    // Runs every command from inFd, answering on outFd. Returns the number
+    // of commands that failed.
+    size_t run(int inFd, int outFd);
+
+    // Runs lines in order inside a heap batch the caller opened, appending
+    // answers to output(). Stops after a POPWAIT that parks and returns the
+    // number of lines consumed.
+    size_t runCommands(const std::vector<std::string_view>& lines);
+    bool waiting() const { return parked; }
+    std::chrono::steady_clock::time_point waitDeadline() const { return parkedUntil; }
+    // Answers a parked POPWAIT if a task is ready or timedOut is set;
+    // returns true once it is answered. Call inside a heap batch.
+    bool resumeWait(bool timedOut);
+    std::string& output() { return out; }
+    // Appends a DEADLINE line for a deadline another client's command passed
+    void reportDeadline(const Task& task) { appendTask("DEADLINE", task); }
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef BINARY_HEAP_QUEUE_HPP
+#define BINARY_HEAP_QUEUE_HPP
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include <unordered_map>
+#include "task_queue.hpp"
+
+// Array-backed binary min-heap with an ID -> slot index, so update and
+// removal by ID run in O(log n).
+//
+// With an aging interval I, a task's effective priority drops by one level
+// for every I pops it waits. Every task ages at the same rate, so ordering
+// by effective priority is ordering by priority * I + (pop count when the
+// task was enqueued). That rank is fixed at push, and waiting tasks are
+// never rewritten.
+//
+// Ranks and the pop count live only in memory. A Task has no field for its
+// enqueue epoch, so reload, restore and journal replay push every task
+// afresh and the wait it had built up is forgotten; replayed executes go
+// through remove(), which does not advance the count either. Aging bounds
+// starvation within one process lifetime, not across restarts.
+class BinaryHeapQueue : public TaskQueue {
+private:
+    struct Entry {
+        int64_t rank;  // Comparison key, stored beside the task it orders
+        Task task;
+    };
+    
+    std::vector<Entry> heap;
+    std::pmr::unsynchronized_pool_resource indexNodes;
+    std::pmr::unordered_map<int, int> taskIndex{&indexNodes};  // Task ID -> current slot in heap
+    int64_t agingInterval;                   // 0 = plain priority order
+    int64_t epoch = 0;                       // Pops so far
+    
+    int64_t rankFor(int priority) const {
+        return agingInterval == 0 ? priority : priority * agingInterval + epoch;
+    }
+    
+    void heapifyUp(int index);
+    void heapifyDown(int index);
+    void swapNodes(int i, int j);
+    Task removeAt(int index);
+    void buildHeap();
+    int getParentIndex(int index) const { return (index - 1) / 2; }
+    int getLeftChildIndex(int index) const { return 2 * index + 1; }
+    int getRightChildIndex(int index) const { return 2 * index + 2; }
+    
+public:
+    explicit BinaryHeapQueue(int popsPerLevel = 0);
+    
+    void push(Task task) override;
+    void pushBatch(std::vector<Task>&& batch) override;
+    Task pop() override;
+    const Task& top() const override { return heap.front().task; }
+    bool updatePriority(int taskId, int newPriority) override;
+    bool remove(int taskId, Task& removed) override;
+    bool contains(int taskId) const override { return taskIndex.count(taskId) > 0; }
+    size_t size() const override { return heap.size(); }
+    void clear() override;
+    std::vector<Task> tasks() const override;
+    int findTaskIndex(int taskId) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef BUCKET_QUEUE_HPP
+#define BUCKET_QUEUE_HPP
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include <unordered_map>
+#include "task_queue.hpp"
+
+// Bucket queue for a bounded integer priority range. Each priority owns a
+// FIFO list threaded through a node pool, and an occupancy bitmap finds the
+// lowest non-empty bucket with a bit scan, so push and pop are O(1) and
+// equal priorities leave in insertion order.
+class BucketQueue : public TaskQueue {
+private:
+    struct Node {
+        Task task;
+        int prev;
+        int next;
+    };
+    struct Bucket {
+        int head = -1;
+        int tail = -1;
+    };
+    
+    int minPriority;
+    int maxPriority;
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    std::vector<Bucket> buckets;
+    std::vector<uint64_t> occupied;  // Bit b set when buckets[b] is non-empty
+    std::pmr::unsynchronized_pool_resource indexNodes;
+    std::pmr::unordered_map<int, int> taskIndex{&indexNodes};  // Task ID -> node
+    
+    int bucketFor(int priority) const;
+    int lowestBucket() const;
+    void link(int node, int bucket);
+    void unlink(int node, int bucket);
+    Task release(int node);
+    
+public:
+    explicit BucketQueue(int lowestPriority = 1, int highestPriority = 100);
+    
+    void push(Task task) override;
+    Task pop() override;
+    const Task& top() const override;
+    bool updatePriority(int taskId, int newPriority) override;
+    bool remove(int taskId, Task& removed) override;
+    bool contains(int taskId) const override { return taskIndex.count(taskId) > 0; }
+    size_t size() const override { return taskIndex.size(); }
+    void clear() override;
+    std::vector<Task> tasks() const override;
+};
+
+#endif
\ No newline at end of file
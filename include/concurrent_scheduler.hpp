@@ -0,0 +1,58 @@
+#ifndef CONCURRENT_SCHEDULER_HPP
+#define CONCURRENT_SCHEDULER_HPP
+
+#include <atomic>
+#include <climits>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "task.hpp"
+#include "dary_heap_queue.hpp"
+
+// Multi-producer / multi-consumer front end made of independently locked
+// sub-heaps. A task lives in the shard chosen by its ID, so update and
+// cancel lock exactly one shard. Pops sample two random shards and take the
+// better cached top ("power of two choices"), which bounds the expected rank
+// error by O(shard count) without any global lock. Nothing is persisted;
+// use snapshot() to hand the contents to a FileManager.
+class ConcurrentScheduler {
+public:
+    // Runs with the task's shard still locked, so state kept beside the
+    // scheduler for that ID leaves at the same moment the task does
+    using TakenCallback = std::function<void(const Task&)>;
+
+private:
+    static const int EMPTY_PRIORITY = INT_MAX;
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        DaryHeapQueue<4> queue;
+        std::atomic<int> topPriority{EMPTY_PRIORITY};  // Read without the lock
+        std::atomic<size_t> count{0};
+
+        void publishTop();
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shardCount;
+
+    Shard& shardFor(int taskId) const;
+    size_t randomShard() const;
+    bool popFrom(Shard& shard, Task& task, const TakenCallback& onTaken);
+
+public:
+    explicit ConcurrentScheduler(size_t shards = 0);
+
+    void addTask(const Task& task);
+    bool tryRemoveHighestPriorityTask(Task& task, const TakenCallback& onTaken = nullptr);
+    void updateTaskPriority(int taskId, int newPriority);
+    Task cancelTask(int taskId, const TakenCallback& onTaken = nullptr);
+    bool isTaskIdExists(int taskId) const;
+    size_t size() const;
+    bool isEmpty() const { return size() == 0; }
+    size_t getShardCount() const { return shardCount; }
+    std::vector<Task> snapshot() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,290 @@
+#ifndef DARY_HEAP_QUEUE_HPP
+#define DARY_HEAP_QUEUE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "task_queue.hpp"
+
+// Ordering policies map a priority onto an unsigned rank; the smallest rank
+// is served first. Flipping the sign bit makes unsigned order match signed
+// order, so every comparison is one unsigned integer compare.
+struct MinFirst {
+    template <typename Key>
+    static constexpr std::make_unsigned_t<Key> rank(Key priority) {
+        using Rank = std::make_unsigned_t<Key>;
+        return static_cast<Rank>(static_cast<Rank>(priority) ^ (Rank(1) << (sizeof(Key) * 8 - 1)));
+    }
+};
+
+struct MaxFirst {
+    template <typename Key>
+    static constexpr std::make_unsigned_t<Key> rank(Key priority) {
+        return static_cast<std::make_unsigned_t<Key>>(~MinFirst::rank(priority));
+    }
+};
+
+// Tie-break policies order equal priorities. A sequenced policy appends a
+// push counter below the priority bits of a 64-bit rank.
+struct NoTieBreak {
+    static constexpr bool sequenced = false;  // Equal priorities leave in any order
+};
+
+struct FifoTieBreak {
+    static constexpr bool sequenced = true;   // Equal priorities leave in arrival order
+};
+
+// d-ary heap over compact (rank, slot) keys. Task payloads live in a
+// separate pool whose slots never move, so sifting only shuffles small keys
+// and each level's children share one or two cache lines. Sifts move a hole
+// instead of swapping, and both directions are iterative.
+//
+// Order, TieBreak and the priority Key type are compile-time policies that
+// fold into the stored rank. With the defaults a key is 8 bytes and the
+// heap is the plain min-heap; FifoTieBreak widens keys to 16 bytes. A Key
+// narrower than int leaves more sequence bits and rejects priorities it
+// cannot hold. Under FIFO an updated task queues behind others at its new
+// priority.
+template <int Arity, typename Order = MinFirst, typename TieBreak = NoTieBreak, typename Key = int>
+class DaryHeapQueue : public TaskQueue {
+    static_assert(Arity >= 2, "A heap needs at least two children per node");
+    static_assert(std::is_integral_v<Key> && std::is_signed_v<Key> && sizeof(Key) <= sizeof(int),
+                  "Priority keys are signed integers no wider than int");
+
+private:
+    using Rank = std::conditional_t<TieBreak::sequenced, uint64_t, std::make_unsigned_t<Key>>;
+    static constexpr int SEQUENCE_BITS = TieBreak::sequenced ? 64 - static_cast<int>(sizeof(Key) * 8) : 0;
+    
+    struct Node {
+        Rank rank;
+        int slot;
+    };
+    
+    std::vector<Node> keys;               // Heap-ordered
+    std::vector<Task> payloads;           // Indexed by slot
+    std::vector<int> heapPos;             // Slot -> index in keys, -1 when free
+    std::vector<int> freeSlots;
+    std::pmr::unsynchronized_pool_resource indexNodes;
+    std::pmr::unordered_map<int, int> slotOf{&indexNodes};  // Task ID -> slot
+    uint64_t nextSequence = 0;            // Sequenced tie-breaks only
+    
+    static void checkFits(int priority) {
+        if constexpr (!std::is_same_v<Key, int>) {
+            if (priority < std::numeric_limits<Key>::min() || priority > std::numeric_limits<Key>::max()) {
+                throw std::out_of_range("Priority does not fit the heap's key type");
+            }
+        }
+    }
+    
+    // Callers check the priority first, so nothing has changed if it throws
+    Rank rankFor(int priority) {
+        Rank rank = Order::rank(static_cast<Key>(priority));
+        if constexpr (TieBreak::sequenced) {
+            if (nextSequence == uint64_t(1) << SEQUENCE_BITS) renumber();
+            rank = rank << SEQUENCE_BITS | nextSequence++;
+        }
+        return rank;
+    }
+    
+    // Reissues sequence numbers 0..n-1 in rank order once the counter runs
+    // out. Relative order is unchanged, so the heap stays valid.
+    void renumber() {
+        std::vector<size_t> order(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [this](size_t a, size_t b) { return keys[a].rank < keys[b].rank; });
+        const Rank priorityMask = ~((Rank(1) << SEQUENCE_BITS) - 1);
+        for (size_t i = 0; i < order.size(); ++i) {
+            keys[order[i]].rank = (keys[order[i]].rank & priorityMask) | i;
+        }
+        nextSequence = keys.size();
+    }
+    
+    void place(size_t index, const Node& key) {
+        keys[index] = key;
+        heapPos[key.slot] = static_cast<int>(index);
+    }
+    
+    void siftUp(size_t index) {
+        Node key = keys[index];
+        while (index > 0) {
+            size_t parent = (index - 1) / Arity;
+            if (keys[parent].rank <= key.rank) break;
+            place(index, keys[parent]);
+            index = parent;
+        }
+        place(index, key);
+    }
+    
+    void siftDown(size_t index) {
+        Node key = keys[index];
+        const size_t count = keys.size();
+        while (true) {
+            size_t first = index * Arity + 1;
+            if (first >= count) break;
+            size_t last = std::min(first + Arity, count);
+            size_t best = first;
+            for (size_t child = first + 1; child < last; ++child) {
+                if (keys[child].rank < keys[best].rank) best = child;
+            }
+            if (keys[best].rank >= key.rank) break;
+            place(index, keys[best]);
+            index = best;
+        }
+        place(index, key);
+    }
+    
+    Task removeAt(size_t index) {
+        int slot = keys[index].slot;
+        Node last = keys.back();
+        keys.pop_back();
+        
+        // Refill the hole with the last key and restore order around it
+        if (index < keys.size()) {
+            place(index, last);
+            siftUp(index);
+            if (heapPos[last.slot] == static_cast<int>(index)) {
+                siftDown(index);
+            }
+        }
+        
+        Task removed = std::move(payloads[slot]);
+        slotOf.erase(removed.getId());
+        heapPos[slot] = -1;
+        freeSlots.push_back(slot);
+        return removed;
+    }
+    
+    int indexOf(int taskId) const {
+        auto it = slotOf.find(taskId);
+        return it == slotOf.end() ? -1 : heapPos[it->second];
+    }
+    
+public:
+    void push(Task task) override {
+        int slot;
+        int taskId = task.getId();
+        checkFits(task.getPriority());
+        Rank rank = rankFor(task.getPriority());
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            payloads[slot] = std::move(task);
+        } else {
+            slot = static_cast<int>(payloads.size());
+            payloads.push_back(std::move(task));
+            heapPos.push_back(-1);
+        }
+        slotOf[taskId] = slot;
+        
+        keys.push_back({rank, slot});
+        heapPos[slot] = static_cast<int>(keys.size() - 1);
+        siftUp(keys.size() - 1);
+    }
+    
+    void pushBatch(std::vector<Task>&& batch) override {
+        for (const auto& task : batch) {
+            checkFits(task.getPriority());
+        }
+        size_t oldSize = keys.size();
+        size_t newSize = oldSize + batch.size();
+        payloads.reserve(payloads.size() + batch.size());
+        keys.reserve(newSize);
+        slotOf.reserve(newSize);
+        
+        // A small batch on a large heap is cheaper to sift up one by one
+        bool siftEach = oldSize > 0 && batch.size() * std::log2(static_cast<double>(newSize)) < newSize;
+        
+        for (auto& task : batch) {
+            int slot = static_cast<int>(payloads.size());
+            slotOf[task.getId()] = slot;
+            keys.push_back({rankFor(task.getPriority()), slot});
+            heapPos.push_back(static_cast<int>(keys.size() - 1));
+            payloads.push_back(std::move(task));
+            if (siftEach) siftUp(keys.size() - 1);
+        }
+        
+        // Otherwise Floyd's bottom-up construction over the whole key array
+        if (!siftEach && keys.size() > 1) {
+            for (size_t index = (keys.size() - 2) / Arity + 1; index-- > 0;) {
+                siftDown(index);
+            }
+        }
+    }
+    
+    Task pop() override { return removeAt(0); }
+    
+    const Task& top() const override { return payloads[keys.front().slot]; }
+    
+    bool updatePriority(int taskId, int newPriority) override {
+        int index = indexOf(taskId);
+        if (index == -1) {
+            return false;
+        }
+        
+        checkFits(newPriority);
+        Rank newRank = rankFor(newPriority);  // May renumber, so read the old rank after
+        Rank oldRank = keys[index].rank;
+        keys[index].rank = newRank;
+        payloads[keys[index].slot].setPriority(newPriority);
+        
+        if (keys[index].rank < oldRank) {
+            siftUp(index);
+        } else {
+            siftDown(index);
+        }
+        return true;
+    }
+    
+    bool remove(int taskId, Task& removed) override {
+        int index = indexOf(taskId);
+        if (index == -1) {
+            return false;
+        }
+        removed = removeAt(index);
+        return true;
+    }
+    
+    bool contains(int taskId) const override { return slotOf.count(taskId) > 0; }
+    size_t size() const override { return keys.size(); }
+    
+    void clear() override {
+        keys.clear();
+        payloads.clear();
+        heapPos.clear();
+        freeSlots.clear();
+        slotOf.clear();
+        nextSequence = 0;
+    }
+    
+    // Heap-array order, which pushBatch rebuilds without sifting. Sequence
+    // numbers are not part of a Task, so a sequenced heap lists its tasks
+    // in pop order instead; pushBatch then reissues them in that order and
+    // equal priorities keep their arrival order through a save and reload.
+    std::vector<Task> tasks() const override {
+        std::vector<Task> result;
+        result.reserve(keys.size());
+        if constexpr (TieBreak::sequenced) {
+            std::vector<Node> ordered(keys);
+            std::sort(ordered.begin(), ordered.end(),
+                      [](const Node& a, const Node& b) { return a.rank < b.rank; });
+            for (const auto& key : ordered) {
+                result.push_back(payloads[key.slot]);
+            }
+        } else {
+            for (const auto& key : keys) {
+                result.push_back(payloads[key.slot]);
+            }
+        }
+        return result;
+    }
+};
+
+#endif
\ No newline at end of file
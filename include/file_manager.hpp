@@ -4,6 +4,14 @@
 #include <string>
 #include <vector>
 #include "task.hpp"
+#include "task_journal.hpp"
+#include "async_logger.hpp"
+#include "task_snapshot.hpp"
+#include "task_report.hpp"
+#include "task_history.hpp"
+#include "background_writer.hpp"
+#include "backup_catalog.hpp"
+#include <atomic>
 #include <fstream>
 #include <ctime>
 #include <iomanip>
@@ -11,27 +19,104 @@
 
 class FileManager {
 private:
-    const std::string TASKS_FILE = "data/tasks.csv";
+    const std::string TASKS_FILE = "data/tasks.snap";
+    const std::string CSV_TASKS_FILE = "data/tasks.csv";
     const std::string LOG_FILE = "data/scheduler_log.txt";
     const std::string BACKUP_DIR = "data/backups/";
     const std::string REPORT_DIR = "data/reports/";
+    const std::string JOURNAL_FILE = "data/tasks.journal";
+    const std::string RETIRED_JOURNAL_FILE = "data/tasks.journal.prev";  // Covered by the snapshot being written
+    const std::string HISTORY_FILE = "data/history.archive";
+    TaskJournal journal{JOURNAL_FILE};
+    HistoryArchive history{HISTORY_FILE};
+    BackupCatalog backupCatalog{BACKUP_DIR};
+    BackupRetention backupRetention;
+    AsyncLogger logger;
+    SnapshotFormat snapshotFormat = SnapshotFormat::Binary;
+    bool syncWrites = true;
+    std::atomic<bool> snapshotInFlight{false};
+    
+    // Incremental backup chain: one full base followed by numbered deltas
+    std::string backupBase;
+    std::string lastBackupStem;  // Names are issued before their files exist
+    size_t backupDeltaCount = 0;
+    bool backupChainOpen = false;  // False once the queue diverges from the chain
+    std::atomic<bool> backupChainBroken{false};  // A delta failed to write in the background
+    ReportConfig reportConfig;
+    std::string lastReportStem;
+    BackgroundWriter reporter;   // Reports, in request order, off the caller's thread
+    BackgroundWriter compactor;  // Folds closed backup chains alongside the writer
+    BackgroundWriter writer;     // Snapshots and backups; last, so it drains first
     
     void createDirectories();
+    const std::string& tasksFile() const;
+    bool writeTaskFile(const std::string& path, const std::vector<Task>& tasks) const;
+    bool publishTaskFile(const std::string& path, const std::vector<Task>& tasks) const;
+    bool publishFile(const std::string& path, const std::string& contents) const;
+    void removeOtherTasksFile();
+    bool readTaskFile(const std::string& path, std::vector<Task>& tasks, std::string& error);
+    void rebuildBackupCatalog();
+    bool matchesCatalog(const std::string& path, uint64_t checksum, uint64_t bytes, std::string& error) const;
+    void catalogBackup(const std::string& path, int64_t createdMs, uint64_t taskCount);
+    void pruneBackups(int64_t protectFromMs);
+    std::string nextBackupStem();
+    bool loadBackupChain(const std::string& deltaFile, std::vector<Task>& tasks, std::string& error);
+    void compactBackupChain(const std::string& basePath);
+    static void applyDelta(std::vector<Task>& tasks, const std::vector<JournalRecord>& records);
     std::string getCurrentTimestamp() const;
     std::string formatDuration(double seconds) const;
 
 public:
-    FileManager();
+    explicit FileManager(const LoggerConfig& loggerConfig = LoggerConfig());
+    ~FileManager();
+    // Both publish atomically: write a temporary file, sync it, rename it
+    // over the old one. saveTasks returns once the file is in place;
+    // saveTasksInBackground retires the journal and writes on the
+    // background writer, returning false while another snapshot is in flight.
     void saveTasks(const std::vector<Task>& tasks);
+    bool saveTasksInBackground(std::vector<Task> tasks);
+    bool snapshotInProgress() const { return snapshotInFlight.load(std::memory_order_acquire); }
+    void setSyncWrites(bool enabled) { syncWrites = enabled; }
+    void waitForWrites() {
+        writer.wait();
+        compactor.wait();
+    }
     std::vector<Task> loadTasks();
+    void setSnapshotFormat(SnapshotFormat format) { snapshotFormat = format; }
+    bool exportCsv(const std::string& path, const std::vector<Task>& tasks);
     void logAction(const std::string& action, const Task& task);
     void logAction(const std::string& action);
-    void createBackup(const std::vector<Task>& tasks);
-    void generateReport(const std::vector<Task>& tasks, 
-                       const std::vector<Task>& completedTasks);
-    std::vector<std::string> getBackupFiles() const;
-    std::string getLatestBackupFile() const;
+    void flushLog() { logger.flush(); }
+    uint64_t droppedLogRecords() const { return logger.dropped(); }
+    void createBackup(std::vector<Task> tasks);
+    bool createIncrementalBackup(const std::vector<JournalRecord>& delta);
+    size_t deltasSinceBase() const { return backupDeltaCount; }
+    void resetBackupChain();
+    // Applied on the compactor thread after each full backup
+    void setBackupRetention(const BackupRetention& retention) { backupRetention = retention; }
+    void setReportConfig(const ReportConfig& config) { reportConfig = config; }
+    // Queues the report for a background thread and returns its summary path
+    std::string generateReport(std::vector<Task> tasks, std::vector<CompletedTask> recentCompleted);
+    void waitForReport();
+    // Listings come from the catalog, never from the backup directory
+    std::vector<BackupEntry> listBackups();
+    std::vector<std::string> getBackupFiles();
+    std::string getLatestBackupFile();
     bool restoreFromBackup(const std::string& backupFile, std::vector<Task>& tasks);
+    
+    // Write-ahead journal on top of the tasks snapshot
+    void appendJournal(const JournalRecord& record) { journal.append(record); }
+    void flushJournal() { journal.flush(); }
+    void truncateJournal();
+    void setJournalGroupSize(size_t records) { journal.setGroupSize(records); }
+    size_t journalSize() const { return journal.size(); }
+    std::vector<JournalRecord> loadJournal() const;
+    bool hasRetiredJournal() const;
+    
+    // Completions pushed out of the in-memory history ring
+    void archiveCompleted(CompletedTask entry) { history.append(std::move(entry)); }
+    void flushHistory() { history.flush(); }
+    void setHistoryBatchSize(size_t entries) { history.setBatchSize(entries); }
 };
 
 #endif
\ No newline at end of file
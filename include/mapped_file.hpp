@@ -0,0 +1,51 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Read-only memory mapping of a whole file, released on destruction.
+class MappedFile {
+private:
+    int fd = -1;
+    const char* bytes = nullptr;
+    size_t length = 0;
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (bytes != nullptr) munmap(const_cast<char*>(bytes), length);
+        if (fd >= 0) close(fd);
+    }
+
+    bool open(const std::string& path) {
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0) return false;
+        length = static_cast<size_t>(info.st_size);
+        if (length == 0) return true;
+
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            length = 0;
+            return false;
+        }
+        madvise(mapped, length, MADV_SEQUENTIAL);
+        bytes = static_cast<const char*>(mapped);
+        return true;
+    }
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+#endif
\ No newline at end of file
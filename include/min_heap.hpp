@@ -2,40 +2,105 @@
 #define MIN_HEAP_HPP
 
 #include <vector>
+#include <functional>
+#include <memory>
 #include <stdexcept>
-#include <unordered_set>  // Add this for tracking task IDs
 #include "task.hpp"
+#include "task_queue.hpp"
 #include "file_manager.hpp"
+#include "scheduler_config.hpp"
+#include "scheduler_stats.hpp"
+#include "timing_wheel.hpp"
+#include "task_history.hpp"
 
 class MinHeap {
 private:
-    std::vector<Task> heap;
-    std::unordered_set<int> existingTaskIds;  // Track existing task IDs
+    std::unique_ptr<TaskQueue> queue;  // Ordering engine chosen by config.engine
     FileManager fileManager;
+    SchedulerConfig config;
+    TimingWheel timers;  // Tasks not yet eligible, and deadlines of all tasks
+    std::function<void(const Task&)> deadlineCallback;
+    bool batching = false;          // Between beginBatch and endBatch
+    bool snapshotPending = false;   // A snapshot save was deferred to endBatch
+    bool backupPending = false;     // An automatic backup was deferred to endBatch
+    size_t completedSinceBackup = 0;
+    size_t changesSinceSnapshot = 0;
+    int64_t lastSnapshotMs = 0;
     
-    void heapifyUp(int index);
-    void heapifyDown(int index);
-    int getParentIndex(int index) const { return (index - 1) / 2; }
-    int getLeftChildIndex(int index) const { return 2 * index + 1; }
-    int getRightChildIndex(int index) const { return 2 * index + 2; }
-    std::vector<Task> completedTasks;
+    static int64_t currentTimeMs();
+    static JournalRecord addRecord(const Task& task);
+    std::vector<Task> allTasks() const;
+    void insertTask(Task task);
+    void insertTasks(std::vector<Task>&& tasks, bool meld = false);
+    void recordMutation(const JournalRecord& record);
+    void replayJournal();
+    HistoryRing completed;  // Most recent completions; older ones are archived
+    std::vector<JournalRecord> backupDelta;  // Changes since the last backup point
+    
+    void releaseDueTimers();
+    Task takeTop();
+    void recordExecuted(const std::vector<Task>& executed);
+    void countCompletions(size_t count);
+    void createAutomaticBackup();
+    void saveSnapshotIfNeeded(size_t changes = 1);
+    void snapshotIfDue();
+    bool snapshotInBackground();
     
 public:
+    explicit MinHeap(const SchedulerConfig& schedulerConfig = SchedulerConfig());
+    ~MinHeap();
+    
+    // Between these calls snapshot saves, journal flushes and automatic
+    // backups are deferred and done once by endBatch
+    void beginBatch();
+    void endBatch();
+    
     void addTask(const Task& task);
+    void addTask(Task&& task);
+    void addTasks(std::vector<Task>&& tasks);
     Task removeHighestPriorityTask();
+    // Batch pops: up to k tasks, or every task whose priority is at most
+    // priorityThreshold, in priority order. The batch is logged, persisted
+    // and checked against the backup policy once; an empty queue gives an
+    // empty vector instead of throwing. With priority aging on, pops follow
+    // aged rank rather than raw priority, so drainUntil throws
+    // std::logic_error; use removeTopK.
+    std::vector<Task> removeTopK(size_t k);
+    std::vector<Task> drainUntil(int priorityThreshold);
     void updateTaskPriority(int taskId, int newPriority);
-    bool isEmpty() const { return heap.empty(); }
-    size_t size() const { return heap.size(); }
+    Task cancelTask(int taskId);
+    bool isEmpty() const { return queue->empty(); }
+    size_t size() const { return queue->size(); }
+    size_t delayedCount() const { return timers.pendingCount(); }
     void displayTasks() const;
-    int findTaskIndex(int taskId) const;
-    bool isTaskIdExists(int taskId) const { return existingTaskIds.count(taskId) > 0; }
+    bool isTaskIdExists(int taskId) const {
+        return queue->contains(taskId) || timers.isPending(taskId);
+    }
+    // Moves tasks whose not-before time has passed into the queue in one
+    // batch and reports passed deadlines; returns the number released
+    size_t advanceTimers(int64_t nowMs = currentTimeMs());
+    void setDeadlineCallback(std::function<void(const Task&)> callback) {
+        deadlineCallback = std::move(callback);
+    }
     void loadFromFile();
     void saveToFile();
+    bool exportToCsv(const std::string& path);
     void createBackup();
-    void generateReport();
+    std::string generateReport();
     bool restoreFromLatestBackup();
-    std::vector<std::string> getRestorePoints() {
-        return fileManager.getBackupFiles();
+    // Adds the latest backup's tasks to the current ones instead of
+    // replacing them; on an ID clash the live task is kept
+    bool mergeLatestBackup();
+    void flushLogs() {
+        fileManager.flushHistory();
+        fileManager.flushLog();
+    }
+    StatsSnapshot stats() const { return SchedulerStats::snapshot(); }
+    // Waits for background snapshot and backup writes to reach the disk
+    void waitForWrites() { fileManager.waitForWrites(); }
+    // Newest first, with the time, size and task count of each
+    std::vector<BackupEntry> getRestorePoints() {
+        return fileManager.listBackups();
     }
 };
 
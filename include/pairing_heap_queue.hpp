@@ -0,0 +1,72 @@
+#ifndef PAIRING_HEAP_QUEUE_HPP
+#define PAIRING_HEAP_QUEUE_HPP
+
+#include <memory>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+#include "task_queue.hpp"
+
+// Pairing min-heap: push, meld and decrease-key are O(1), and pop is
+// amortized O(log n) with the two-pass sibling merge. Nodes come from
+// blocks this queue owns and are recycled through a free list. Blocks
+// never move, so a node's address is a stable handle. Melding adopts the
+// other queue's blocks instead of copying them. Only the ID index takes
+// time proportional to the melded queue, and the smaller index is always
+// the one folded into the larger.
+class PairingHeapQueue : public TaskQueue {
+private:
+    struct Node {
+        Task task;
+        Node* child = nullptr;    // Leftmost child
+        Node* next = nullptr;     // Right sibling; next free node on the free list
+        Node* prev = nullptr;     // Left sibling, or the parent of a leftmost child
+    };
+
+    // Held by pointer so two queues can trade indexes in O(1) when melding
+    struct IdIndex {
+        std::pmr::unsynchronized_pool_resource nodes;
+        std::pmr::unordered_map<int, Node*> map{&nodes};  // Task ID -> node
+    };
+
+    Node* root = nullptr;
+    std::vector<std::unique_ptr<Node[]>> blocks;
+    size_t nextBlockSize = 64;
+    Node* freeHead = nullptr;
+    Node* freeTail = nullptr;
+    std::unique_ptr<IdIndex> index = std::make_unique<IdIndex>();
+    std::vector<Node*> pairs;  // Reused scratch for the two-pass merge
+
+    Node* allocate(Task task);
+    void release(Node* node);
+    static Node* link(Node* first, Node* second);
+    Node* mergeSiblings(Node* first);
+    void cut(Node* node);
+    void detach(Node* node);
+    Node* find(int taskId) const;
+
+public:
+    // Opaque, stable reference to a queued task, valid until it leaves
+    using Handle = Node*;
+
+    void push(Task task) override;
+    Handle pushHandle(Task task);
+    Task pop() override;
+    const Task& top() const override { return root->task; }
+    bool updatePriority(int taskId, int newPriority) override;
+    // O(1); newPriority must not be larger than the task's current one
+    void decreaseKey(Handle handle, int newPriority);
+    Handle handleOf(int taskId) const { return find(taskId); }
+    bool remove(int taskId, Task& removed) override;
+    bool contains(int taskId) const override { return index->map.count(taskId) > 0; }
+    size_t size() const override { return index->map.size(); }
+    void clear() override;
+    std::vector<Task> tasks() const override;
+
+    // Takes every task out of other in O(1) plus the smaller ID index;
+    // callers guarantee the IDs are disjoint
+    void meld(PairingHeapQueue& other);
+    void merge(TaskQueue& other) override;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef SCHEDULER_CLIENT_HPP
+#define SCHEDULER_CLIENT_HPP
+
+#include <deque>
+#include <string>
+#include <vector>
+#include "task.hpp"
+
+// One daemon answer. Pops fill tasks and set empty when the queue ran out
+// first; STATS leaves its line in text. DEADLINE lines the daemon sent
+// ahead of the answer are collected in deadlines.
+struct DaemonReply {
+    bool ok = true;
+    std::string error;  // The ERR message when ok is false
+    std::vector<Task> tasks;
+    bool empty = false;
+    std::string text;
+    std::vector<Task> deadlines;
+};
+
+// Blocking connection to a SchedulerDaemon. The queue* calls only buffer a
+// command, so many can be pipelined: send() writes them all at once and
+// readReply() returns the answers in the order the commands were queued.
+// The one-shot helpers send a single command and wait for its answer.
+// Throws std::runtime_error when the daemon cannot be reached.
+class SchedulerClient {
+private:
+    enum class ReplyKind { Status, Pop, Stats };
+    struct Expected {
+        ReplyKind kind;
+        size_t count;  // Tasks a pop can return
+    };
+
+    int fd = -1;
+    std::string out;
+    std::string in;
+    size_t inPos = 0;
+    std::deque<Expected> expected;
+
+    bool readLine(std::string& line);
+
+public:
+    explicit SchedulerClient(const std::string& socketPath = "data/scheduler.sock");
+    ~SchedulerClient();
+
+    SchedulerClient(const SchedulerClient&) = delete;
+    SchedulerClient& operator=(const SchedulerClient&) = delete;
+
+    void queueAdd(const Task& task);
+    void queuePop(size_t count = 1);
+    void queuePopWait(int timeoutMs, size_t count = 1);
+    void queueUpdate(int taskId, int newPriority);
+    void queueCancel(int taskId);
+    void queueStats();
+    void send();
+    size_t outstanding() const { return expected.size(); }
+    // Answer to the oldest command sent and not yet answered
+    DaemonReply readReply();
+
+    DaemonReply add(const Task& task);
+    std::vector<Task> pop(size_t count = 1);
+    std::vector<Task> popWait(int timeoutMs, size_t count = 1);
+    DaemonReply update(int taskId, int newPriority);
+    DaemonReply cancel(int taskId);
+    std::string stats();
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef SCHEDULER_CONFIG_HPP
+#define SCHEDULER_CONFIG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "async_logger.hpp"
+#include "task_snapshot.hpp"
+#include "task_report.hpp"
+#include "backup_catalog.hpp"
+
+enum class PersistenceMode {
+    Snapshot,  // Rewrite tasks.csv after every state change
+    Journal    // Append small records to tasks.journal, snapshot on compaction
+};
+
+// When snapshot persistence writes a new snapshot. Snapshots are copied on
+// the caller's thread and written in the background, so a slower trigger
+// trades how much a crash can lose for less copying.
+enum class SnapshotTrigger {
+    EveryChange,  // After every mutation
+    EveryN,       // After snapshotEveryChanges mutations
+    Interval      // At most once per snapshotIntervalMs while changes are pending
+};
+
+enum class QueueEngine {
+    BinaryHeap,  // General-purpose binary heap, any int priority
+    BucketQueue, // O(1) FIFO buckets for priorities in [minPriority, maxPriority]
+    DaryHeap,    // heapArity-ary heap of compact keys over a stable payload pool
+    PairingHeap  // Pooled pairing heap: O(1) push, meld and decrease-key
+};
+
+struct SchedulerConfig {
+    QueueEngine engine = QueueEngine::BinaryHeap;
+    int minPriority = 1;                          // Priority range for bounded engines
+    int maxPriority = 100;
+    int heapArity = 4;                            // 4 or 8, used by QueueEngine::DaryHeap
+    bool fifoTies = false;                        // Equal priorities pop in arrival order; DaryHeap or BucketQueue
+    int agingInterval = 0;                        // Pops per priority level gained while waiting; 0 = off, BinaryHeap only
+    PersistenceMode persistence = PersistenceMode::Journal;
+    SnapshotTrigger snapshotTrigger = SnapshotTrigger::EveryChange;  // Snapshot persistence only
+    size_t snapshotEveryChanges = 100;
+    int64_t snapshotIntervalMs = 1000;
+    bool syncWrites = true;                       // fsync snapshots and backups before publishing
+    size_t journalGroupSize = 32;                 // Records buffered per journal flush
+    size_t journalCompactBytes = 4 * 1024 * 1024; // Snapshot once the journal grows past this
+    bool incrementalBackups = true;               // Auto backups write deltas between full bases
+    size_t deltasPerBase = 10;                    // Full base backup after this many deltas
+    size_t maxBackupDeltaRecords = 1 << 20;       // Larger deltas fall back to a full base
+    SnapshotFormat snapshotFormat = SnapshotFormat::Binary;  // tasks file and backups
+    BackupRetention backupRetention;              // Which old full backups are kept
+    int64_t timerTickMs = 10;                     // Resolution of not-before and deadline timers
+    size_t historyCapacity = 10;                  // Recent completions kept in memory
+    size_t historyArchiveBatch = 256;             // Older completions written per archive block
+    LoggerConfig logging;
+    ReportConfig reporting;
+};
+
+#endif
\ No newline at end of file
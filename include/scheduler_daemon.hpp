@@ -0,0 +1,88 @@
+#ifndef SCHEDULER_DAEMON_HPP
+#define SCHEDULER_DAEMON_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "batch_runner.hpp"
+
+struct DaemonConfig {
+    std::string socketPath = "data/scheduler.sock";
+    size_t maxConnections = 1024;
+    size_t maxCommandsPerRound = 256;       // Per connection, so one client cannot starve the rest
+    size_t maxPendingOutputBytes = 4 << 20; // Stop reading from a client this far behind on answers
+    int waitTickMs = 10;                    // Timer resolution while POPWAIT clients are parked
+};
+
+// Serves one MinHeap to many local clients over a Unix domain socket, so
+// producers and consumers share a queue instead of each owning a copy of
+// the tasks file. Clients speak the BatchRunner protocol and may pipeline
+// any number of commands; answers come back in order. A single thread runs
+// an epoll loop: every round reads what the ready connections sent, runs
+// their commands inside one heap batch, so the round is journaled and
+// flushed once, then writes the answers. POPWAIT parks a client until a
+// task arrives or its timeout passes; later commands on that connection
+// wait behind it. Deadlines passed during a round are sent as DEADLINE
+// lines to a parked client if there is one, else to the first client
+// answered that round; with no such client they wait for the next round.
+class SchedulerDaemon {
+private:
+    struct Connection {
+        int fd;
+        std::string input;
+        BatchRunner runner;
+        uint32_t events = 0;      // Interest currently registered with epoll
+        bool readClosed = false;  // Peer shut down its side; answer, then close
+        bool queued = false;      // Listed in ready
+        bool touched = false;     // Listed in pendingWrites
+
+        Connection(int socket, MinHeap& heap, const BatchConfig& config)
+            : fd(socket), runner(heap, config) {}
+    };
+
+    MinHeap& heap;
+    DaemonConfig config;
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1;  // stop() writes here to end run()
+    bool running = false;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+    std::vector<int> ready;          // Connections with commands to run this round
+    std::vector<int> waiters;        // Parked POPWAIT connections, oldest first
+    std::vector<int> pendingWrites;  // Connections with new answers this round
+    std::vector<Task> expired;       // Passed deadlines not yet sent to a client
+    std::vector<std::string_view> lines;
+    std::vector<size_t> lineEnds;
+
+    void acceptClients();
+    void readFrom(Connection& connection);
+    void schedule(Connection& connection);
+    void serve(Connection& connection);
+    void resumeWaiters();
+    void reportDeadlines(const std::vector<int>& served);
+    void answered(Connection& connection);
+    bool flushOutput(Connection& connection);
+    void watch(Connection& connection);
+    void close(int fd);
+    int pollTimeoutMs() const;
+
+public:
+    explicit SchedulerDaemon(MinHeap& scheduler, const DaemonConfig& daemonConfig = DaemonConfig());
+    ~SchedulerDaemon();
+
+    SchedulerDaemon(const SchedulerDaemon&) = delete;
+    SchedulerDaemon& operator=(const SchedulerDaemon&) = delete;
+
+    // Binds the socket; throws if it is in use by a live daemon, or if the
+    // path holds something other than a socket
+    void listen();
+    // Serves clients until stop() is called
+    void run();
+    // Safe from any thread and from a signal handler
+    void stop();
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef SCHEDULER_STATS_HPP
+#define SCHEDULER_STATS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <ostream>
+
+// Build with -DSCHEDULER_ENABLE_STATS=0 to compile every timer out
+#ifndef SCHEDULER_ENABLE_STATS
+#define SCHEDULER_ENABLE_STATS 1
+#endif
+
+enum class StatOp {
+    Add,
+    Pop,
+    Update,
+    Cancel,
+    Save,
+    Load,
+    Log,
+    Backup,
+    Restore
+};
+
+constexpr size_t STAT_OP_COUNT = static_cast<size_t>(StatOp::Restore) + 1;
+
+struct OpStats {
+    uint64_t count = 0;
+    uint64_t failed = 0;   // Calls that left through an exception
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+    uint64_t p50Ns = 0;    // Percentiles are bucket upper bounds, within ~6%
+    uint64_t p90Ns = 0;
+    uint64_t p99Ns = 0;
+
+    double meanNs() const { return count == 0 ? 0 : static_cast<double>(totalNs) / count; }
+};
+
+struct StatsSnapshot {
+    bool enabled = SCHEDULER_ENABLE_STATS != 0;
+    std::array<OpStats, STAT_OP_COUNT> ops;
+
+    const OpStats& operator[](StatOp op) const { return ops[static_cast<size_t>(op)]; }
+};
+
+// Process-wide latency histograms. Each thread records into its own block of
+// log-linear buckets (16 sub-buckets per power of two, HDR style) with plain
+// relaxed stores, so the hot path takes no lock and shares no cache line.
+// snapshot() merges every live block plus the counts of threads that exited.
+namespace SchedulerStats {
+
+const char* opName(StatOp op);
+StatsSnapshot snapshot();
+void reset();  // Best effort while other threads are still recording
+void print(std::ostream& out, const StatsSnapshot& stats);
+
+#if SCHEDULER_ENABLE_STATS
+void record(StatOp op, uint64_t nanoseconds, bool failed);
+
+class ScopedTimer {
+private:
+    StatOp op;
+    int exceptions;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(StatOp timedOp)
+        : op(timedOp), exceptions(std::uncaught_exceptions()),
+          start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        record(op, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+               std::uncaught_exceptions() > exceptions);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+#endif
+
+}  // namespace SchedulerStats
+
+// Times the rest of the enclosing scope as one sample of op
+#if SCHEDULER_ENABLE_STATS
+#define SCHEDULER_STAT_SCOPE(op) SchedulerStats::ScopedTimer schedulerStatTimer(op)
+#else
+#define SCHEDULER_STAT_SCOPE(op) ((void)0)
+#endif
+
+#endif
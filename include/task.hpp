@@ -1,26 +1,41 @@
 #ifndef TASK_HPP
 #define TASK_HPP
 
-#include <string>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include "task_text.hpp"
 
 class Task {
 private:
     int taskId;
-    std::string description;
     int priority;
+    TaskText description;  // Shared, so copying a task does not allocate
+    int64_t notBefore = 0;  // Eligible from this time, ms since the epoch; 0 = now
+    int64_t deadline = 0;   // Reported as expired after this time; 0 = none
     
 public:
-    Task(int id = 0, const std::string& desc = "", int prio = 0)
-        : taskId(id), description(desc), priority(prio) {}
+    Task(int id = 0, std::string_view desc = {}, int prio = 0)
+        : taskId(id), priority(prio), description(desc) {}
+    Task(int id, TaskText desc, int prio)
+        : taskId(id), priority(prio), description(std::move(desc)) {}
     
     int getId() const { return taskId; }
-    std::string getDescription() const { return description; }
+    std::string_view getDescription() const { return description.view(); }
+    const TaskText& getDescriptionText() const { return description; }
     int getPriority() const { return priority; }
     void setPriority(int newPriority) { priority = newPriority; }
+    int64_t getNotBefore() const { return notBefore; }
+    void setNotBefore(int64_t timeMs) { notBefore = timeMs; }
+    int64_t getDeadline() const { return deadline; }
+    void setDeadline(int64_t timeMs) { deadline = timeMs; }
+    bool hasTimers() const { return notBefore != 0 || deadline != 0; }
     
     bool operator>(const Task& other) const {
         return priority > other.priority;
     }
 };
 
+static_assert(sizeof(Task) == 40, "Task should stay five words");
+
 #endif
\ No newline at end of file
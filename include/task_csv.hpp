@@ -0,0 +1,37 @@
+#ifndef TASK_CSV_HPP
+#define TASK_CSV_HPP
+
+#include <string>
+#include <vector>
+#include "task.hpp"
+
+struct CsvParseError {
+    size_t line;  // 1-based line number in the file
+    std::string message;
+};
+
+struct CsvLoadResult {
+    bool opened = false;
+    std::vector<Task> tasks;
+    std::vector<CsvParseError> errors;
+};
+
+// Reader and writer for the "TaskID,Priority,NotBefore,Deadline,Description"
+// text format shared by tasks.csv and CSV backups. Files whose header lacks
+// the NotBefore column, or that have no header, use the original
+// "TaskID,Priority,Description" layout. Descriptions containing commas or quotes are
+// quoted with doubled inner quotes; unquoted legacy rows keep the rest of
+// the line as the description. Records are one per line, so line breaks in
+// descriptions are written as spaces.
+class TaskCsv {
+public:
+    static const char* const HEADER;
+
+    // Memory-maps the file, splits it into newline-aligned chunks and parses
+    // them in parallel. threads == 0 uses the hardware concurrency.
+    static CsvLoadResult load(const std::string& path, unsigned threads = 0);
+    static bool write(const std::string& path, const std::vector<Task>& tasks);
+    static void appendRow(std::string& out, const Task& task);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef TASK_EXECUTOR_HPP
+#define TASK_EXECUTOR_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "task.hpp"
+#include "concurrent_scheduler.hpp"
+#include "file_manager.hpp"
+#include "task_history.hpp"
+
+struct ExecutorConfig {
+    size_t workers = 0;        // 0 = one per hardware thread
+    size_t batchSize = 8;      // Tasks a worker takes from the scheduler at once
+    size_t historyLimit = 10;  // Recent completions kept in memory; older ones are archived
+};
+
+// Runs the callables attached to scheduled tasks on a worker pool. Workers
+// pull small priority-ordered batches from the ConcurrentScheduler into a
+// local deque and steal from the back of other workers' deques when idle.
+// Completions are handed to a separate thread that logs them and keeps the
+// recent ones in a HistoryRing, archiving those it pushes out through the
+// FileManager as MinHeap does, so workers never wait on file I/O. Give the
+// executor a FileManager no MinHeap writes history to. stop() returns work
+// still sitting in local deques to the scheduler.
+class TaskExecutor {
+private:
+    struct Job {
+        Task task;
+        std::function<void()> work;
+    };
+
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+        std::thread thread;
+    };
+
+    // Callables keyed by task ID, sharded like the scheduler itself. An entry
+    // leaves under the scheduler's shard lock when its task is popped or
+    // cancelled, so it exists exactly while the ID is taken.
+    struct alignas(64) WorkShard {
+        std::mutex mutex;
+        std::unordered_map<int, std::function<void()>> work;
+    };
+
+    ConcurrentScheduler& scheduler;
+    FileManager* fileManager;
+    ExecutorConfig config;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<WorkShard> workShards;
+
+    std::atomic<bool> running{true};
+    std::atomic<size_t> inFlight{0};   // Taken from the scheduler, not yet finished
+    std::atomic<size_t> completed{0};
+    std::mutex idleMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+
+    std::mutex completionMutex;
+    std::condition_variable completionReady;
+    std::vector<CompletedTask> pendingCompletions;
+    HistoryRing completedTasks;
+    std::thread completionThread;
+
+    WorkShard& shardFor(int taskId);
+    std::function<void()> takeWork(int taskId);
+    bool popLocal(Worker& worker, Job& job);
+    bool refill(Worker& worker);
+    bool steal(size_t thief, Job& job);
+    void run(Job& job, std::vector<CompletedTask>& finished);
+    void publishCompletions(std::vector<CompletedTask>& finished);
+    void workerLoop(size_t index);
+    void completionLoop();
+
+public:
+    TaskExecutor(ConcurrentScheduler& taskScheduler, FileManager* logTarget = nullptr,
+                 const ExecutorConfig& executorConfig = ExecutorConfig());
+    ~TaskExecutor();
+
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    void submit(const Task& task, std::function<void()> work);
+    // Removes a queued task and its callable together; throws if the task
+    // is not queued. Use this rather than the scheduler's cancelTask.
+    Task cancel(int taskId);
+    void waitIdle();
+    void stop();
+    size_t completedCount() const { return completed.load(std::memory_order_acquire); }
+    std::vector<Task> getCompletedTasks();
+};
+
+#endif
\ No newline at end of file
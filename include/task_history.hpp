@@ -0,0 +1,75 @@
+#ifndef TASK_HISTORY_HPP
+#define TASK_HISTORY_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include "task.hpp"
+
+struct CompletedTask {
+    Task task;
+    int64_t completedMs = 0;  // ms since the epoch
+};
+
+// Fixed-capacity ring of the most recent completions. Once full, each push
+// overwrites the oldest slot and hands that entry back, so nothing shifts.
+class HistoryRing {
+private:
+    std::vector<CompletedTask> slots;
+    size_t next = 0;   // Slot the next entry is written to
+    size_t count = 0;
+
+public:
+    explicit HistoryRing(size_t capacity = 10) : slots(capacity) {}
+
+    // True when an older entry was pushed out into evicted; with capacity 0
+    // the new entry itself is evicted
+    bool push(CompletedTask entry, CompletedTask& evicted);
+    size_t size() const { return count; }
+    size_t capacity() const { return slots.size(); }
+    std::vector<CompletedTask> recent() const;  // Oldest first
+};
+
+struct HistorySummary {
+    uint64_t count = 0;
+    int64_t firstMs = 0;  // Oldest and newest archived completion
+    int64_t lastMs = 0;
+    std::map<int, uint64_t> priorityCounts;
+    uint64_t archiveBytes = 0;
+    bool truncated = false;  // A torn or corrupt block ended the scan early
+};
+
+// Append-only archive of completions that fell out of the ring. Entries
+// gather in memory and are written as one checksummed block per batch.
+// Inside a block IDs and times are zigzag varint deltas from the previous
+// entry, and a description repeated within the block is a back-reference,
+// so a typical entry takes a few bytes. A crash loses at most the unwritten
+// batch. Readers stop at a torn final block, and the next writer cuts it
+// off before appending.
+class HistoryArchive {
+private:
+    std::string path;
+    std::ofstream out;
+    std::vector<CompletedTask> pending;
+    size_t batchSize = 256;
+    std::string block;  // Reused encode buffer
+
+    void open();
+
+public:
+    explicit HistoryArchive(const std::string& archivePath);
+    ~HistoryArchive();
+
+    void setBatchSize(size_t entries) { batchSize = entries == 0 ? 1 : entries; }
+    void append(CompletedTask entry);
+    void flush();
+    size_t pendingCount() const { return pending.size(); }
+
+    static void encodeBlock(std::string& out, const std::vector<CompletedTask>& entries);
+    static std::vector<CompletedTask> readAll(const std::string& path, bool* truncated = nullptr);
+    static HistorySummary summarize(const std::string& path);
+};
+
+#endif
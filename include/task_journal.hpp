@@ -0,0 +1,62 @@
+#ifndef TASK_JOURNAL_HPP
+#define TASK_JOURNAL_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+#include "task_text.hpp"
+
+enum class JournalOp : char {
+    Add = 'A',
+    Execute = 'X',
+    Update = 'U',
+    Cancel = 'C'
+};
+
+struct JournalRecord {
+    JournalOp op;
+    int taskId;
+    int priority;
+    TaskText description;   // Add only; shares the task's text
+    int64_t notBefore = 0;  // Add only
+    int64_t deadline = 0;
+};
+
+// Append-only log of queue mutations. Records are buffered and written as a
+// group, so a crash loses at most the records of the group not yet flushed.
+class TaskJournal {
+private:
+    std::string path;
+    std::ofstream out;
+    std::string pending;
+    size_t pendingRecords = 0;
+    size_t groupSize = 32;
+    size_t bytesWritten = 0;
+
+    void open();
+
+public:
+    explicit TaskJournal(const std::string& journalPath);
+    ~TaskJournal();
+
+    void setGroupSize(size_t records) { groupSize = records == 0 ? 1 : records; }
+    void append(const JournalRecord& record);
+    void flush();
+    void truncate();
+    // Flushes and moves the records written so far to retiredPath, leaving
+    // an empty journal. A retired file left by an unpublished snapshot is
+    // appended to, never overwritten.
+    void rotate(const std::string& retiredPath);
+    size_t size() const { return bytesWritten + pending.size(); }
+    std::vector<JournalRecord> readAll() const { return readFile(path); }
+    static std::vector<JournalRecord> readFile(const std::string& path);
+
+    // Line format shared with incremental backups: "A,id,priority,description",
+    // "U,id,priority", "X,id" or "C,id". Adds with a not-before time or a
+    // deadline are written as "T,id,priority,notBefore,deadline,description".
+    static void formatRecord(std::string& out, const JournalRecord& record);
+    static std::vector<JournalRecord> parseRecords(const std::string& contents);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef TASK_QUEUE_HPP
+#define TASK_QUEUE_HPP
+
+#include <cstddef>
+#include <vector>
+#include "task.hpp"
+
+// Ordering engine behind MinHeap. An engine owns the queued tasks and their
+// ID lookup; MinHeap layers validation, persistence, logging and history on
+// top, so every engine exposes the same scheduler API. Engines keep their
+// ID index in a pmr map over a pool they own, so the node freed by a pop is
+// reused by the next push instead of going back to the global allocator.
+class TaskQueue {
+public:
+    virtual ~TaskQueue() = default;
+
+    // Takes the task by value so a temporary is moved all the way in
+    virtual void push(Task task) = 0;
+    // Bulk insert; callers guarantee the IDs are unique. Heap engines
+    // override this with a bottom-up build.
+    virtual void pushBatch(std::vector<Task>&& batch) {
+        for (auto& task : batch) push(std::move(task));
+    }
+    // Moves every task out of other, leaving it empty; callers guarantee
+    // the IDs are disjoint. Mergeable engines override this to meld.
+    virtual void merge(TaskQueue& other) {
+        std::vector<Task> moved = other.tasks();
+        other.clear();
+        pushBatch(std::move(moved));
+    }
+    virtual Task pop() = 0;
+    virtual const Task& top() const = 0;
+    virtual bool updatePriority(int taskId, int newPriority) = 0;
+    virtual bool remove(int taskId, Task& removed) = 0;
+    virtual bool contains(int taskId) const = 0;
+    virtual size_t size() const = 0;
+    virtual void clear() = 0;
+    virtual std::vector<Task> tasks() const = 0;
+    bool empty() const { return size() == 0; }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef TASK_REPORT_HPP
+#define TASK_REPORT_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "task.hpp"
+#include "task_history.hpp"
+#include "scheduler_stats.hpp"
+
+struct ReportConfig {
+    size_t topK = 100;        // Tasks shown on the summary page
+    size_t pageSize = 1000;   // Tasks per listing page
+};
+
+// Everything a report shows, copied off the scheduler so the report can be
+// written on another thread while the queue keeps changing.
+struct ReportData {
+    std::string timestamp;
+    std::vector<Task> tasks;
+    std::vector<CompletedTask> recentCompleted;  // Oldest first
+    HistorySummary archivedHistory;               // Completions older than the ring
+    StatsSnapshot stats;
+};
+
+// HTML report writer. "<stem>.html" holds the summary, the top-K tasks, a
+// priority histogram, recent completions, a summary of the archived
+// history and operation latency; the full
+// listing, in priority order, goes to "<stem>_pNNNN.html" pages of
+// config.pageSize tasks. Output is built in a large buffer and written in
+// blocks, and every description is HTML-escaped.
+class TaskReport {
+public:
+    static bool write(const std::string& stem, ReportData& data, const ReportConfig& config);
+    static void appendEscaped(std::string& out, std::string_view text);
+    static std::string pagePath(const std::string& stem, size_t page);
+};
+
+#endif
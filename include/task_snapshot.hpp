@@ -0,0 +1,41 @@
+#ifndef TASK_SNAPSHOT_HPP
+#define TASK_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "task.hpp"
+
+enum class SnapshotFormat {
+    Binary,  // Versioned fixed-width records (default)
+    Csv      // Human-readable TaskID,Priority,Description rows
+};
+
+struct SnapshotLoadResult {
+    bool opened = false;
+    std::string error;  // Empty when the snapshot loaded cleanly
+    std::vector<Task> tasks;
+};
+
+// Binary snapshot of the queue, little-endian (builds are refused on
+// big-endian hosts, since structs are copied in host byte order):
+//
+//   header   magic "PRIOHEAT", version, record size, task count,
+//            string table size, checksum, reserved
+//   records  taskCount x {int32 id, int32 priority, uint32 offset, uint32 length,
+//                         int64 notBefore, int64 deadline}
+//   strings  descriptions, each distinct text stored once
+//
+// The checksum covers records and strings. Records keep the order they were
+// written in, so a heap saved in array order loads back without any sifting.
+// Version 1 files, whose records stop after length, still load with no timers.
+class TaskSnapshot {
+public:
+    static const uint32_t VERSION = 2;
+
+    static bool isSnapshotFile(const std::string& path);
+    static bool write(const std::string& path, const std::vector<Task>& tasks);
+    static SnapshotLoadResult load(const std::string& path);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef TASK_TEXT_HPP
+#define TASK_TEXT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// Immutable task description in 16 bytes. Short text is stored inline;
+// longer text lives in a reference-counted block that copies share, so
+// copying a Task into a queue, log record or journal record never
+// allocates. Blocks come from a process-wide pool that reuses freed
+// blocks, so a steady stream of tasks stops reaching the global allocator.
+class TaskText {
+private:
+    struct Block {
+        std::atomic<uint32_t> refs;
+        uint32_t length;
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    static const size_t INLINE_CAPACITY = 15;
+    static const uint8_t IN_BLOCK = 0xFF;  // Tag value when block is used
+
+    // Inline text, or a Block* in the leading bytes; the last byte is the
+    // tag: the inline length, or IN_BLOCK
+    alignas(Block*) char bytes[INLINE_CAPACITY + 1];
+
+    uint8_t tag() const noexcept { return static_cast<uint8_t>(bytes[INLINE_CAPACITY]); }
+    void setTag(uint8_t value) noexcept { bytes[INLINE_CAPACITY] = static_cast<char>(value); }
+    bool inBlock() const noexcept { return tag() == IN_BLOCK; }
+    Block* block() const noexcept {
+        Block* pointer;
+        std::memcpy(&pointer, bytes, sizeof(pointer));
+        return pointer;
+    }
+    void retain() const noexcept {
+        if (inBlock()) block()->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    void release() noexcept;
+
+public:
+    TaskText() noexcept : bytes{} {}
+    explicit TaskText(std::string_view text);
+    TaskText(const TaskText& other) noexcept {
+        std::memcpy(static_cast<void*>(this), &other, sizeof(TaskText));
+        retain();
+    }
+    TaskText(TaskText&& other) noexcept {
+        std::memcpy(static_cast<void*>(this), &other, sizeof(TaskText));
+        other.setTag(0);
+    }
+    ~TaskText() { release(); }
+
+    TaskText& operator=(const TaskText& other) noexcept {
+        if (this != &other) {
+            other.retain();
+            release();
+            std::memcpy(static_cast<void*>(this), &other, sizeof(TaskText));
+        }
+        return *this;
+    }
+    TaskText& operator=(TaskText&& other) noexcept {
+        if (this != &other) {
+            release();
+            std::memcpy(static_cast<void*>(this), &other, sizeof(TaskText));
+            other.setTag(0);
+        }
+        return *this;
+    }
+
+    std::string_view view() const noexcept {
+        return inBlock() ? std::string_view(block()->data(), block()->length)
+                         : std::string_view(bytes, tag());
+    }
+    size_t size() const noexcept { return inBlock() ? block()->length : tag(); }
+    bool empty() const noexcept { return tag() == 0; }
+};
+
+static_assert(sizeof(TaskText) == 16, "TaskText must stay two words");
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef TIMING_WHEEL_HPP
+#define TIMING_WHEEL_HPP
+
+#include <cstdint>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+#include "task.hpp"
+
+// Hierarchical timing wheel holding tasks that are not yet eligible
+// (release timers) and the deadlines of queued tasks (deadline timers).
+// Four levels of 64 slots cover 2^24 ticks; later timers wait in an
+// overflow list that is re-sorted whenever the top level wraps. Slots are
+// lists threaded through a node pool and indexed by task ID, so schedule,
+// cancel and priority updates are O(1). advance() jumps straight to the
+// next occupied slot using per-level occupancy bitmaps, so idle time costs
+// nothing and each timer is cascaded at most once per level.
+class TimingWheel {
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int OVERFLOW_SLOT = LEVELS * SLOTS;
+
+    enum class Kind : uint8_t { Release, Deadline };
+
+    struct Node {
+        Task task;
+        uint64_t expiry;  // Tick at which the timer fires
+        int prev;
+        int next;
+        int slot;
+        Kind kind;
+    };
+
+    int64_t tickMs;
+    uint64_t currentTick;  // Every timer due at or before this tick has fired
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    std::vector<int> heads;            // LEVELS * SLOTS slots plus the overflow list
+    uint64_t occupied[LEVELS] = {};    // Bit s set when slot s of the level is non-empty
+    std::pmr::unsynchronized_pool_resource indexNodes;  // Recycles index nodes
+    std::pmr::unordered_map<int, int> releaseIndex{&indexNodes};   // Task ID -> release node
+    std::pmr::unordered_map<int, int> deadlineIndex{&indexNodes};  // Task ID -> deadline node
+
+    uint64_t tickFor(int64_t timeMs) const;
+    int allocate(const Task& task, uint64_t expiry, Kind kind);
+    void place(int node);
+    void link(int node, int slot);
+    void unlink(int node);
+    int detachSlot(int slot);
+    uint64_t nextEventTick() const;
+    void processTick(std::vector<Task>& released, std::vector<Task>& expired);
+    Task releaseNode(int node);
+
+public:
+    explicit TimingWheel(int64_t tickMilliseconds = 10, int64_t nowMs = 0);
+
+    // False when the task is already eligible and belongs in the queue
+    bool scheduleRelease(const Task& task);
+    // Deadlines already in the past fire on the next advance()
+    void scheduleDeadline(const Task& task);
+    bool cancelRelease(int taskId, Task& removed);
+    void cancelDeadline(int taskId);
+    bool updatePriority(int taskId, int newPriority);
+    bool isPending(int taskId) const { return releaseIndex.count(taskId) > 0; }
+    size_t pendingCount() const { return releaseIndex.size(); }
+    size_t deadlineCount() const { return deadlineIndex.size(); }
+    std::vector<Task> pendingTasks() const;
+    void clear();
+
+    // Fires every timer due at nowMs: released tasks and tasks whose
+    // deadline passed are appended to the two vectors
+    void advance(int64_t nowMs, std::vector<Task>& released, std::vector<Task>& expired);
+};
+
+#endif
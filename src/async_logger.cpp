@@ -0,0 +1,199 @@
+#include "async_logger.hpp"
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+}  // namespace
+
+AsyncLogger::AsyncLogger(const std::string& logPath, const LoggerConfig& loggerConfig)
+    : path(logPath), config(loggerConfig) {
+    size_t capacity = roundUpToPowerOfTwo(config.queueCapacity);
+    slots.reset(new Slot[capacity]);
+    for (size_t i = 0; i < capacity; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask = capacity - 1;
+    if (config.batchSize == 0) config.batchSize = 1;
+
+    writer = std::thread(&AsyncLogger::writerLoop, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running.store(false, std::memory_order_release);
+    }
+    wakeWriter.notify_one();
+    writer.join();
+}
+
+bool AsyncLogger::tryPush(LogRecord& record) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        Slot& slot = slots[pos & mask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.record = std::move(record);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // Ring is full
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool AsyncLogger::tryPop(LogRecord& record) {
+    Slot& slot = slots[dequeuePos & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+        return false;
+    }
+    record = std::move(slot.record);
+    slot.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+    ++dequeuePos;
+    return true;
+}
+
+void AsyncLogger::log(LogRecord record) {
+    while (!tryPush(record)) {
+        switch (config.overflow) {
+            case OverflowPolicy::Block:
+                wakeWriter.notify_one();
+                std::this_thread::yield();
+                break;
+            case OverflowPolicy::Drop:
+                return;
+            case OverflowPolicy::CountDrops:
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+        }
+    }
+
+    // Only wake the writer once a batch worth of records is waiting
+    size_t backlog = enqueuePos.load(std::memory_order_relaxed) -
+                     writtenCount.load(std::memory_order_relaxed);
+    if (backlog >= config.batchSize) {
+        wakeWriter.notify_one();
+    }
+}
+
+void AsyncLogger::flush() {
+    size_t target = enqueuePos.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    wakeWriter.notify_one();
+    batchWritten.wait(lock, [&] {
+        return writtenCount.load(std::memory_order_acquire) >= target;
+    });
+}
+
+const std::string& AsyncLogger::timestampFor(std::chrono::system_clock::time_point time) {
+    std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    if (seconds != cachedSecond || cachedTimestamp.empty()) {
+        std::tm local{};
+        localtime_r(&seconds, &local);
+        char text[32];
+        std::strftime(text, sizeof(text), "%Y%m%d_%H%M%S", &local);
+        cachedTimestamp = text;
+        cachedSecond = seconds;
+    }
+    return cachedTimestamp;
+}
+
+void AsyncLogger::appendFormatted(std::string& buffer, const LogRecord& record) {
+    buffer += timestampFor(record.time);
+    buffer += " - ";
+    buffer += record.action;
+    if (record.hasTask) {
+        buffer += " - Task ID: ";
+        buffer += std::to_string(record.taskId);
+        buffer += ", Priority: ";
+        buffer += std::to_string(record.priority);
+        buffer += ", Description: ";
+        buffer += record.description.view();
+    }
+    buffer += '\n';
+}
+
+void AsyncLogger::openLog() {
+    out.open(path, std::ios::app | std::ios::binary);
+    std::error_code ec;
+    fileBytes = fs::exists(path, ec) ? fs::file_size(path, ec) : 0;
+}
+
+void AsyncLogger::rotate() {
+    out.close();
+    std::error_code ec;
+    if (config.maxRotatedFiles <= 0) {
+        fs::remove(path, ec);
+    } else {
+        fs::remove(path + "." + std::to_string(config.maxRotatedFiles), ec);
+        for (int i = config.maxRotatedFiles - 1; i >= 1; --i) {
+            std::string from = path + "." + std::to_string(i);
+            if (fs::exists(from, ec)) {
+                fs::rename(from, path + "." + std::to_string(i + 1), ec);
+            }
+        }
+        fs::rename(path, path + ".1", ec);
+    }
+    openLog();
+}
+
+void AsyncLogger::writerLoop() {
+    std::string buffer;
+    LogRecord record;
+
+    while (true) {
+        size_t drained = 0;
+        while (drained < config.batchSize && tryPop(record)) {
+            appendFormatted(buffer, record);
+            ++drained;
+        }
+
+        if (config.overflow == OverflowPolicy::CountDrops) {
+            uint64_t drops = droppedCount.load(std::memory_order_relaxed);
+            if (drops != reportedDrops) {
+                LogRecord note;
+                note.time = std::chrono::system_clock::now();
+                note.action = "Logger dropped " + std::to_string(drops - reportedDrops) +
+                              " records (queue full)";
+                appendFormatted(buffer, note);
+                reportedDrops = drops;
+            }
+        }
+
+        if (!buffer.empty()) {
+            if (!out.is_open()) openLog();
+            out.write(buffer.data(), buffer.size());
+            out.flush();
+            fileBytes += buffer.size();
+            buffer.clear();
+            if (fileBytes >= config.maxFileBytes) rotate();
+        }
+
+        if (drained > 0) {
+            writtenCount.fetch_add(drained, std::memory_order_release);
+            { std::lock_guard<std::mutex> lock(wakeMutex); }
+            batchWritten.notify_all();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        if (!running.load(std::memory_order_acquire)) break;
+        wakeWriter.wait_for(lock, std::chrono::milliseconds(20), [&] {
+            return !running.load(std::memory_order_acquire) ||
+                   enqueuePos.load(std::memory_order_acquire) != dequeuePos;
+        });
+    }
+}
@@ -0,0 +1,46 @@
+#include "background_writer.hpp"
+
+BackgroundWriter::BackgroundWriter(size_t maxQueuedJobs)
+    : maxQueued(maxQueuedJobs == 0 ? 1 : maxQueuedJobs), worker(&BackgroundWriter::run, this) {}
+
+BackgroundWriter::~BackgroundWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    jobReady.notify_one();
+    worker.join();
+}
+
+void BackgroundWriter::submit(std::function<void()> job) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        roomFree.wait(lock, [this] { return jobs.size() < maxQueued; });
+        jobs.push_back(std::move(job));
+    }
+    jobReady.notify_one();
+}
+
+void BackgroundWriter::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    drained.wait(lock, [this] { return jobs.empty() && !busy; });
+}
+
+void BackgroundWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        jobReady.wait(lock, [this] { return !jobs.empty() || !running; });
+        if (jobs.empty()) return;  // Stopped with nothing left to write
+
+        std::function<void()> job = std::move(jobs.front());
+        jobs.pop_front();
+        busy = true;
+        lock.unlock();
+        roomFree.notify_one();
+        job();
+        job = nullptr;  // Frees the job's task copy before going idle
+        lock.lock();
+        busy = false;
+        if (jobs.empty()) drained.notify_all();
+    }
+}
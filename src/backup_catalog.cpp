@@ -0,0 +1,243 @@
+#include "backup_catalog.hpp"
+#include "mapped_file.hpp"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* MANIFEST_NAME = "MANIFEST";
+const uint64_t CHECKSUM_SEED = 0xcbf29ce484222325ULL;
+const int64_t HOUR_MS = 3600LL * 1000;
+const int64_t DAY_MS = 24 * HOUR_MS;
+
+bool olderThan(const BackupEntry& a, const BackupEntry& b) {
+    return a.createdMs != b.createdMs ? a.createdMs < b.createdMs : a.path < b.path;
+}
+
+// "<stem>_dNNNN.delta" -> "<stem>"
+std::string baseStemOf(const std::string& deltaPath) {
+    return deltaPath.substr(0, deltaPath.rfind("_d"));
+}
+
+std::string stemOf(const std::string& path) {
+    return path.substr(0, path.size() - fs::path(path).extension().string().size());
+}
+
+bool parseEntry(const std::string& line, const std::string& directory, BackupEntry& entry) {
+    // B,<ms>,<file>,<bytes>,<tasks>,<checksum>
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) fields.push_back(field);
+    if (fields.size() != 6 || fields[2].empty()) return false;
+    try {
+        entry.createdMs = std::stoll(fields[1]);
+        entry.path = directory + fields[2];
+        entry.bytes = std::stoull(fields[3]);
+        entry.taskCount = std::stoull(fields[4]);
+        entry.checksum = std::stoull(fields[5], nullptr, 16);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+bool BackupEntry::isDelta() const {
+    return fs::path(path).extension() == ".delta";
+}
+
+BackupCatalog::BackupCatalog(const std::string& backupDirectory)
+    : directory(backupDirectory), manifestPath(backupDirectory + MANIFEST_NAME) {}
+
+std::string BackupCatalog::formatEntry(const BackupEntry& entry) {
+    char numbers[96];
+    std::snprintf(numbers, sizeof(numbers), ",%" PRIu64 ",%" PRIu64 ",%016" PRIx64 "\n",
+                  entry.bytes, entry.taskCount, entry.checksum);
+    return "B," + std::to_string(entry.createdMs) + "," +
+           fs::path(entry.path).filename().string() + numbers;
+}
+
+bool BackupCatalog::load() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    paths.clear();
+    staleRecords = 0;
+
+    std::ifstream file(manifestPath, std::ios::binary);
+    if (!file.is_open()) return false;
+
+    // Later lines win, so replay into a map and order once at the end
+    std::unordered_map<std::string, BackupEntry> byPath;
+    size_t records = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (file.eof()) break;  // No newline: a torn append
+        ++records;
+        if (line.rfind("B,", 0) == 0) {
+            BackupEntry entry;
+            if (parseEntry(line, directory, entry)) byPath[entry.path] = std::move(entry);
+        } else if (line.rfind("R,", 0) == 0) {
+            byPath.erase(directory + line.substr(2));
+        }
+    }
+
+    for (auto& [path, entry] : byPath) {
+        paths.insert(path);
+        entries.push_back(std::move(entry));
+    }
+    std::sort(entries.begin(), entries.end(), olderThan);
+    staleRecords = records - entries.size();
+    return true;
+}
+
+void BackupCatalog::rebuild(std::vector<BackupEntry> found) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries = std::move(found);
+    std::sort(entries.begin(), entries.end(), olderThan);
+    paths.clear();
+    for (const auto& entry : entries) paths.insert(entry.path);
+    staleRecords = entries.size() + 1;  // Forces the rewrite below
+    rewriteIfStale();
+}
+
+void BackupCatalog::appendLine(const std::string& line) {
+    if (!out.is_open()) {
+        out.open(manifestPath, std::ios::app | std::ios::binary);
+    }
+    out.write(line.data(), line.size());
+    out.flush();
+}
+
+void BackupCatalog::rewriteIfStale() {
+    if (staleRecords <= entries.size()) return;
+
+    std::string contents;
+    for (const auto& entry : entries) contents += formatEntry(entry);
+
+    // Same publish as the tasks file: a crash keeps the old manifest or the new one
+    if (out.is_open()) out.close();
+    std::string temporary = manifestPath + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), contents.size());
+        if (!file) return;  // Keep appending to the old manifest
+    }
+    std::error_code ec;
+    fs::rename(temporary, manifestPath, ec);
+    if (!ec) staleRecords = 0;
+}
+
+void BackupCatalog::add(BackupEntry entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!paths.insert(entry.path).second) {
+        entries.erase(std::find_if(entries.begin(), entries.end(),
+                                   [&](const BackupEntry& e) { return e.path == entry.path; }));
+        ++staleRecords;
+    }
+    appendLine(formatEntry(entry));
+    entries.insert(std::upper_bound(entries.begin(), entries.end(), entry, olderThan), std::move(entry));
+    rewriteIfStale();
+}
+
+void BackupCatalog::remove(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (paths.erase(path) == 0) return;
+    entries.erase(std::find_if(entries.begin(), entries.end(),
+                               [&](const BackupEntry& e) { return e.path == path; }));
+    appendLine("R," + fs::path(path).filename().string() + "\n");
+    staleRecords += 2;  // The entry's line and this one
+    rewriteIfStale();
+}
+
+bool BackupCatalog::contains(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return paths.count(path) > 0;
+}
+
+bool BackupCatalog::find(const std::string& path, BackupEntry& entry) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (paths.count(path) == 0) return false;
+    entry = *std::find_if(entries.begin(), entries.end(),
+                          [&](const BackupEntry& e) { return e.path == path; });
+    return true;
+}
+
+bool BackupCatalog::latest(BackupEntry& entry) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entries.empty()) return false;
+    entry = entries.back();
+    return true;
+}
+
+std::vector<BackupEntry> BackupCatalog::list() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::vector<BackupEntry>(entries.rbegin(), entries.rend());
+}
+
+size_t BackupCatalog::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+std::vector<std::string> BackupCatalog::expired(const BackupRetention& retention, int64_t protectFromMs) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> dropped;
+    if (retention.keepLast == 0) return dropped;
+
+    // A base with deltas still listed is part of a chain a restore may need
+    std::unordered_set<std::string> chained;
+    for (const auto& entry : entries) {
+        if (entry.isDelta()) chained.insert(baseStemOf(stemOf(entry.path)));
+    }
+
+    size_t fullSeen = 0;
+    size_t hoursSeen = 0;
+    size_t daysSeen = 0;
+    int64_t lastHour = INT64_MIN;
+    int64_t lastDay = INT64_MIN;
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+        if (it->isDelta()) continue;
+
+        // Walking newest first, the first backup seen in a bucket is its newest
+        bool keep = fullSeen++ < retention.keepLast;
+        int64_t hour = it->createdMs / HOUR_MS;
+        if (hour != lastHour) {
+            lastHour = hour;
+            keep |= hoursSeen++ < retention.keepHourly;
+        }
+        int64_t day = it->createdMs / DAY_MS;
+        if (day != lastDay) {
+            lastDay = day;
+            keep |= daysSeen++ < retention.keepDaily;
+        }
+
+        if (!keep && it->createdMs < protectFromMs && !chained.count(stemOf(it->path))) {
+            dropped.push_back(it->path);
+        }
+    }
+    return dropped;
+}
+
+uint64_t BackupCatalog::checksum(std::string_view data) {
+    uint64_t hash = CHECKSUM_SEED;
+    for (unsigned char byte : data) {
+        hash = (hash ^ byte) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool BackupCatalog::checksumFile(const std::string& path, uint64_t& checksum, uint64_t& bytes) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    checksum = BackupCatalog::checksum(std::string_view(file.data(), file.size()));
+    bytes = file.size();
+    return true;
+}
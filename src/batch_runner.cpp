@@ -0,0 +1,324 @@
+#include "batch_runner.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+
+const size_t READ_BLOCK_BYTES = 1 << 20;
+
+std::string_view nextToken(std::string_view& rest) {
+    size_t start = rest.find_first_not_of(" \t");
+    if (start == std::string_view::npos) {
+        rest = {};
+        return {};
+    }
+    size_t end = rest.find_first_of(" \t", start);
+    if (end == std::string_view::npos) end = rest.size();
+    std::string_view token = rest.substr(start, end - start);
+    rest.remove_prefix(end);
+    return token;
+}
+
+bool parseInt(std::string_view token, int& value) {
+    if (token.empty()) return false;
+    auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+    return result.ec == std::errc() && result.ptr == token.data() + token.size();
+}
+
+bool isValidPriority(int priority) {
+    return priority >= 1 && priority <= 100;  // Same range as the interactive menu
+}
+
+void appendInt(std::string& out, long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+}  // namespace
+
+BatchRunner::BatchRunner(MinHeap& scheduler, const BatchConfig& batchConfig)
+    : heap(scheduler), config(batchConfig) {
+    if (config.maxCommands == 0) config.maxCommands = 1;
+}
+
+void BatchRunner::fail(const std::string& message) {
+    ++failures;
+    out += "ERR ";
+    appendInt(out, static_cast<long long>(lineNumber));
+    out += ' ';
+    out += message;
+    out += '\n';
+}
+
+void BatchRunner::appendTask(const char* tag, const Task& task) {
+    out += tag;
+    out += ' ';
+    appendInt(out, task.getId());
+    out += ' ';
+    appendInt(out, task.getPriority());
+    out += ' ';
+    out += task.getDescription();
+    out += '\n';
+}
+
+void BatchRunner::queueAdd(std::string_view args) {
+    int id = 0;
+    int priority = 0;
+    if (!parseInt(nextToken(args), id) || id <= 0) {
+        fail("invalid task ID");
+        return;
+    }
+    if (!parseInt(nextToken(args), priority) || !isValidPriority(priority)) {
+        fail("priority must be between 1 and 100");
+        return;
+    }
+    size_t start = args.find_first_not_of(" \t");
+    if (start == std::string_view::npos) {
+        fail("task description cannot be empty");
+        return;
+    }
+    if (heap.isTaskIdExists(id) || !pendingIds.insert(id).second) {
+        fail("task ID already exists");
+        return;
+    }
+
+    // Validated here, so the grouped addTasks cannot fail for this task
+    pendingAdds.emplace_back(id, std::string(args.substr(start)), priority);
+    out += "OK\n";
+}
+
+void BatchRunner::flushAdds() {
+    if (pendingAdds.empty()) return;
+    heap.addTasks(std::move(pendingAdds));
+    pendingAdds.clear();
+    pendingIds.clear();
+}
+
+void BatchRunner::answerPop(const std::vector<Task>& executed, size_t count) {
+    for (const auto& task : executed) {
+        appendTask("TASK", task);
+    }
+    if (executed.size() < count) {
+        out += "EMPTY\n";
+    }
+}
+
+void BatchRunner::pop(std::string_view args) {
+    int count = 1;
+    std::string_view token = nextToken(args);
+    if (!token.empty() && (!parseInt(token, count) || count <= 0)) {
+        fail("invalid pop count");
+        return;
+    }
+    answerPop(heap.removeTopK(static_cast<size_t>(count)), static_cast<size_t>(count));
+}
+
+void BatchRunner::popWait(std::string_view args) {
+    int timeoutMs = 0;
+    int count = 1;
+    if (!parseInt(nextToken(args), timeoutMs) || timeoutMs < 0) {
+        fail("usage: POPWAIT <timeout ms> [count]");
+        return;
+    }
+    std::string_view token = nextToken(args);
+    if (!token.empty() && (!parseInt(token, count) || count <= 0)) {
+        fail("invalid pop count");
+        return;
+    }
+
+    if (!config.allowWait || timeoutMs == 0 || !heap.isEmpty()) {
+        answerPop(heap.removeTopK(static_cast<size_t>(count)), static_cast<size_t>(count));
+        return;
+    }
+    parked = true;
+    parkedCount = static_cast<size_t>(count);
+    parkedUntil = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+}
+
+bool BatchRunner::resumeWait(bool timedOut) {
+    if (!parked) return true;
+    if (!timedOut && heap.isEmpty()) return false;
+    parked = false;
+    try {
+        answerPop(heap.removeTopK(parkedCount), parkedCount);
+    } catch (const std::exception& e) {
+        fail(e.what());
+    }
+    return true;
+}
+
+void BatchRunner::drain(std::string_view args) {
+    int threshold = 0;
+    if (!parseInt(nextToken(args), threshold)) {
+        fail("usage: DRAIN <priority>");
+        return;
+    }
+    std::vector<Task> executed = heap.drainUntil(threshold);
+    for (const auto& task : executed) {
+        appendTask("TASK", task);
+    }
+    out += "DRAINED ";
+    appendInt(out, static_cast<long long>(executed.size()));
+    out += '\n';
+}
+
+void BatchRunner::stats() {
+    StatsSnapshot snapshot = heap.stats();
+    out += "STATS";
+    if (!snapshot.enabled) {
+        out += " disabled\n";
+        return;
+    }
+    for (size_t op = 0; op < STAT_OP_COUNT; ++op) {
+        const OpStats& s = snapshot.ops[op];
+        out += ' ';
+        out += SchedulerStats::opName(static_cast<StatOp>(op));
+        out += '=';
+        appendInt(out, static_cast<long long>(s.count));
+        out += ',';
+        appendInt(out, static_cast<long long>(s.p50Ns));
+        out += ',';
+        appendInt(out, static_cast<long long>(s.p99Ns));
+    }
+    out += '\n';
+}
+
+void BatchRunner::execute(std::string_view line) {
+    ++lineNumber;
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    std::string_view args = line;
+    std::string_view command = nextToken(args);
+    if (command.empty() || command.front() == '#') return;
+
+    if (command == "ADD") {
+        queueAdd(args);
+        return;
+    }
+
+    // Everything else must see the queued adds
+    flushAdds();
+    try {
+        if (command == "POP") {
+            pop(args);
+        } else if (command == "POPWAIT") {
+            popWait(args);
+        } else if (command == "DRAIN") {
+            drain(args);
+        } else if (command == "UPDATE") {
+            int id = 0;
+            int priority = 0;
+            if (!parseInt(nextToken(args), id) || !parseInt(nextToken(args), priority) ||
+                !isValidPriority(priority)) {
+                fail("usage: UPDATE <id> <priority 1-100>");
+                return;
+            }
+            heap.updateTaskPriority(id, priority);
+            out += "OK\n";
+        } else if (command == "CANCEL") {
+            int id = 0;
+            if (!parseInt(nextToken(args), id)) {
+                fail("usage: CANCEL <id>");
+                return;
+            }
+            heap.cancelTask(id);
+            out += "OK\n";
+        } else if (command == "SAVE") {
+            heap.saveToFile();
+            out += "OK\n";
+        } else if (command == "BACKUP") {
+            heap.createBackup();
+            out += "OK\n";
+        } else if (command == "STATS") {
+            stats();
+        } else {
+            fail("unknown command " + std::string(command));
+        }
+    } catch (const std::exception& e) {
+        fail(e.what());
+    }
+}
+
+size_t BatchRunner::runCommands(const std::vector<std::string_view>& lines) {
+    for (size_t i = 0; i < lines.size(); ++i) {
+        execute(lines[i]);
+        if (parked) return i + 1;  // Later answers must follow this one
+    }
+    flushAdds();
+    return lines.size();
+}
+
+void BatchRunner::runBatch(const std::vector<std::string_view>& lines) {
+    heap.beginBatch();
+    heap.advanceTimers();
+    runCommands(lines);
+    heap.endBatch();
+}
+
+bool BatchRunner::writeOut(int fd) {
+    const char* data = out.data();
+    size_t remaining = out.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    out.clear();
+    return true;
+}
+
+size_t BatchRunner::run(int inFd, int outFd) {
+    heap.setDeadlineCallback([this](const Task& task) { appendTask("DEADLINE", task); });
+
+    std::string input;
+    std::vector<std::string_view> lines;
+    bool atEnd = false;
+    while (!atEnd) {
+        // Take whatever is available, so a pipe gets answers per write
+        size_t used = input.size();
+        input.resize(used + READ_BLOCK_BYTES);
+        ssize_t got = ::read(inFd, &input[used], READ_BLOCK_BYTES);
+        if (got < 0 && errno == EINTR) {
+            input.resize(used);
+            continue;
+        }
+        input.resize(used + (got > 0 ? static_cast<size_t>(got) : 0));
+        atEnd = got <= 0;
+
+        // Complete lines only; a trailing partial line waits for more input
+        size_t consumed = 0;
+        lines.clear();
+        while (consumed < input.size()) {
+            const char* start = input.data() + consumed;
+            const char* newline = static_cast<const char*>(
+                std::memchr(start, '\n', input.size() - consumed));
+            if (newline == nullptr) {
+                if (!atEnd) break;
+                lines.emplace_back(start, input.size() - consumed);
+                consumed = input.size();
+            } else {
+                lines.emplace_back(start, newline - start);
+                consumed = newline - input.data() + 1;
+            }
+            if (lines.size() == config.maxCommands) {
+                runBatch(lines);
+                lines.clear();
+                if (!writeOut(outFd)) return failures + 1;
+            }
+        }
+        if (!lines.empty()) {
+            runBatch(lines);
+            if (!writeOut(outFd)) return failures + 1;
+        }
+        input.erase(0, consumed);
+    }
+
+    heap.setDeadlineCallback(nullptr);
+    return failures;
+}
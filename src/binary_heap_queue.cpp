@@ -0,0 +1,178 @@
+#include "binary_heap_queue.hpp"
+#include <cmath>
+
+BinaryHeapQueue::BinaryHeapQueue(int popsPerLevel)
+    : agingInterval(popsPerLevel > 0 ? popsPerLevel : 0) {}
+
+void BinaryHeapQueue::swapNodes(int i, int j) {
+    std::swap(heap[i], heap[j]);
+    taskIndex[heap[i].task.getId()] = i;
+    taskIndex[heap[j].task.getId()] = j;
+}
+
+void BinaryHeapQueue::heapifyUp(int index) {
+    while (index > 0) {
+        int parentIndex = getParentIndex(index);
+        if (heap[parentIndex].rank > heap[index].rank) {
+            swapNodes(index, parentIndex);
+            index = parentIndex;
+        } else {
+            break;
+        }
+    }
+}
+
+void BinaryHeapQueue::heapifyDown(int index) {
+    int smallestIndex = index;
+    int leftChild = getLeftChildIndex(index);
+    int rightChild = getRightChildIndex(index);
+    
+    if (leftChild < static_cast<int>(heap.size()) && heap[leftChild].rank < heap[smallestIndex].rank) {
+        smallestIndex = leftChild;
+    }
+    
+    if (rightChild < static_cast<int>(heap.size()) && heap[rightChild].rank < heap[smallestIndex].rank) {
+        smallestIndex = rightChild;
+    }
+    
+    if (smallestIndex != index) {
+        swapNodes(index, smallestIndex);
+        heapifyDown(smallestIndex);
+    }
+}
+
+void BinaryHeapQueue::push(Task task) {
+    taskIndex[task.getId()] = heap.size();  // Track the new slot
+    heap.push_back({rankFor(task.getPriority()), std::move(task)});
+    heapifyUp(heap.size() - 1);
+}
+
+void BinaryHeapQueue::pushBatch(std::vector<Task>&& batch) {
+    size_t oldSize = heap.size();
+    size_t newSize = oldSize + batch.size();
+    heap.reserve(newSize);
+    taskIndex.reserve(newSize);
+    
+    // A small batch on a large heap is cheaper to sift up one by one
+    if (oldSize > 0 && batch.size() * std::log2(static_cast<double>(newSize)) < newSize) {
+        for (auto& task : batch) {
+            heap.push_back({rankFor(task.getPriority()), std::move(task)});
+            taskIndex[heap.back().task.getId()] = heap.size() - 1;
+            heapifyUp(heap.size() - 1);
+        }
+        return;
+    }
+    
+    for (auto& task : batch) {
+        heap.push_back({rankFor(task.getPriority()), std::move(task)});
+    }
+    buildHeap();
+}
+
+void BinaryHeapQueue::buildHeap() {
+    // Floyd's bottom-up construction: sift down every internal node, then
+    // index the final slots in one pass instead of on every swap
+    int count = heap.size();
+    for (int start = count / 2 - 1; start >= 0; --start) {
+        int index = start;
+        while (true) {
+            int smallestIndex = index;
+            int leftChild = getLeftChildIndex(index);
+            int rightChild = getRightChildIndex(index);
+            if (leftChild < count && heap[leftChild].rank < heap[smallestIndex].rank) {
+                smallestIndex = leftChild;
+            }
+            if (rightChild < count && heap[rightChild].rank < heap[smallestIndex].rank) {
+                smallestIndex = rightChild;
+            }
+            if (smallestIndex == index) break;
+            std::swap(heap[index], heap[smallestIndex]);
+            index = smallestIndex;
+        }
+    }
+    
+    taskIndex.clear();
+    for (int i = 0; i < count; ++i) {
+        taskIndex.emplace(heap[i].task.getId(), i);
+    }
+}
+
+Task BinaryHeapQueue::removeAt(int index) {
+    Task removed = std::move(heap[index].task);
+    taskIndex.erase(removed.getId());
+    
+    // Move the last element into the vacated slot
+    int lastIndex = heap.size() - 1;
+    if (index != lastIndex) {
+        heap[index] = std::move(heap[lastIndex]);
+        taskIndex[heap[index].task.getId()] = index;
+    }
+    heap.pop_back();
+    
+    // The moved element may violate the heap property in either direction
+    if (index < static_cast<int>(heap.size())) {
+        int movedId = heap[index].task.getId();
+        heapifyUp(index);
+        if (taskIndex[movedId] == index) {
+            heapifyDown(index);
+        }
+    }
+    return removed;
+}
+
+Task BinaryHeapQueue::pop() {
+    ++epoch;
+    return removeAt(0);
+}
+
+int BinaryHeapQueue::findTaskIndex(int taskId) const {
+    auto it = taskIndex.find(taskId);
+    return it == taskIndex.end() ? -1 : it->second;
+}
+
+bool BinaryHeapQueue::updatePriority(int taskId, int newPriority) {
+    int index = findTaskIndex(taskId);
+    if (index == -1) {
+        return false;
+    }
+    
+    // Keep the task's enqueue epoch so an update does not reset its wait
+    int64_t oldRank = heap[index].rank;
+    if (agingInterval == 0) {
+        heap[index].rank = newPriority;
+    } else {
+        int64_t enqueueEpoch = oldRank - heap[index].task.getPriority() * agingInterval;
+        heap[index].rank = newPriority * agingInterval + enqueueEpoch;
+    }
+    heap[index].task.setPriority(newPriority);
+    
+    if (heap[index].rank < oldRank) {
+        heapifyUp(index);
+    } else {
+        heapifyDown(index);
+    }
+    return true;
+}
+
+std::vector<Task> BinaryHeapQueue::tasks() const {
+    std::vector<Task> result;
+    result.reserve(heap.size());
+    for (const auto& entry : heap) {
+        result.push_back(entry.task);
+    }
+    return result;
+}
+
+bool BinaryHeapQueue::remove(int taskId, Task& removed) {
+    int index = findTaskIndex(taskId);
+    if (index == -1) {
+        return false;
+    }
+    removed = removeAt(index);
+    return true;
+}
+
+void BinaryHeapQueue::clear() {
+    heap.clear();
+    taskIndex.clear();
+}
@@ -0,0 +1,145 @@
+#include "bucket_queue.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+BucketQueue::BucketQueue(int lowestPriority, int highestPriority)
+    : minPriority(lowestPriority), maxPriority(highestPriority) {
+    if (highestPriority < lowestPriority) {
+        throw std::invalid_argument("Bucket queue priority range is empty");
+    }
+    int bucketCount = highestPriority - lowestPriority + 1;
+    buckets.resize(bucketCount);
+    occupied.assign((bucketCount + 63) / 64, 0);
+}
+
+int BucketQueue::bucketFor(int priority) const {
+    if (priority < minPriority || priority > maxPriority) {
+        throw std::out_of_range("Priority " + std::to_string(priority) +
+                                " is outside the bucket queue range " +
+                                std::to_string(minPriority) + "-" + std::to_string(maxPriority));
+    }
+    return priority - minPriority;
+}
+
+int BucketQueue::lowestBucket() const {
+    // The bitmap is a handful of words, so this scan is constant time
+    for (size_t word = 0; word < occupied.size(); ++word) {
+        if (occupied[word] != 0) {
+            return static_cast<int>(word * 64 + __builtin_ctzll(occupied[word]));
+        }
+    }
+    return -1;
+}
+
+void BucketQueue::link(int node, int bucket) {
+    Bucket& b = buckets[bucket];
+    nodes[node].prev = b.tail;
+    nodes[node].next = -1;
+    if (b.tail == -1) {
+        b.head = node;
+        occupied[bucket / 64] |= uint64_t(1) << (bucket % 64);
+    } else {
+        nodes[b.tail].next = node;
+    }
+    b.tail = node;
+}
+
+void BucketQueue::unlink(int node, int bucket) {
+    Bucket& b = buckets[bucket];
+    Node& n = nodes[node];
+    if (n.prev == -1) b.head = n.next; else nodes[n.prev].next = n.next;
+    if (n.next == -1) b.tail = n.prev; else nodes[n.next].prev = n.prev;
+    if (b.head == -1) {
+        occupied[bucket / 64] &= ~(uint64_t(1) << (bucket % 64));
+    }
+}
+
+Task BucketQueue::release(int node) {
+    Task task = std::move(nodes[node].task);
+    taskIndex.erase(task.getId());
+    freeNodes.push_back(node);
+    return task;
+}
+
+void BucketQueue::push(Task task) {
+    int bucket = bucketFor(task.getPriority());
+    int taskId = task.getId();
+    
+    int node;
+    if (!freeNodes.empty()) {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[node].task = std::move(task);
+    } else {
+        node = static_cast<int>(nodes.size());
+        nodes.push_back({std::move(task), -1, -1});
+    }
+    
+    link(node, bucket);
+    taskIndex[taskId] = node;
+}
+
+const Task& BucketQueue::top() const {
+    int bucket = lowestBucket();
+    if (bucket == -1) {
+        throw std::runtime_error("Heap is empty");
+    }
+    return nodes[buckets[bucket].head].task;
+}
+
+Task BucketQueue::pop() {
+    int bucket = lowestBucket();
+    if (bucket == -1) {
+        throw std::runtime_error("Heap is empty");
+    }
+    int node = buckets[bucket].head;
+    unlink(node, bucket);
+    return release(node);
+}
+
+bool BucketQueue::updatePriority(int taskId, int newPriority) {
+    auto it = taskIndex.find(taskId);
+    if (it == taskIndex.end()) {
+        return false;
+    }
+    
+    int newBucket = bucketFor(newPriority);
+    int node = it->second;
+    unlink(node, bucketFor(nodes[node].task.getPriority()));
+    nodes[node].task.setPriority(newPriority);
+    link(node, newBucket);
+    return true;
+}
+
+bool BucketQueue::remove(int taskId, Task& removed) {
+    auto it = taskIndex.find(taskId);
+    if (it == taskIndex.end()) {
+        return false;
+    }
+    
+    int node = it->second;
+    unlink(node, bucketFor(nodes[node].task.getPriority()));
+    removed = release(node);
+    return true;
+}
+
+void BucketQueue::clear() {
+    nodes.clear();
+    freeNodes.clear();
+    taskIndex.clear();
+    std::fill(buckets.begin(), buckets.end(), Bucket());
+    std::fill(occupied.begin(), occupied.end(), 0);
+}
+
+std::vector<Task> BucketQueue::tasks() const {
+    // Buckets are walked in priority order, so the result is already sorted
+    std::vector<Task> result;
+    result.reserve(taskIndex.size());
+    for (const auto& bucket : buckets) {
+        for (int node = bucket.head; node != -1; node = nodes[node].next) {
+            result.push_back(nodes[node].task);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,133 @@
+#include "concurrent_scheduler.hpp"
+#include "scheduler_stats.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+void ConcurrentScheduler::Shard::publishTop() {
+    topPriority.store(queue.empty() ? EMPTY_PRIORITY : queue.top().getPriority(),
+                      std::memory_order_relaxed);
+    count.store(queue.size(), std::memory_order_relaxed);
+}
+
+ConcurrentScheduler::ConcurrentScheduler(size_t shards) {
+    if (shards == 0) {
+        // A few shards per core keeps two random picks unlikely to collide
+        shards = 4 * std::max(1u, std::thread::hardware_concurrency());
+    }
+    shardCount = shards;
+    this->shards.reset(new Shard[shardCount]);
+}
+
+ConcurrentScheduler::Shard& ConcurrentScheduler::shardFor(int taskId) const {
+    // Fibonacci hashing spreads sequential IDs evenly across shards
+    uint64_t hash = static_cast<uint64_t>(static_cast<uint32_t>(taskId)) * 0x9E3779B97F4A7C15ULL;
+    return shards[(hash >> 32) % shardCount];
+}
+
+size_t ConcurrentScheduler::randomShard() const {
+    thread_local std::minstd_rand rng(std::random_device{}());
+    return rng() % shardCount;
+}
+
+void ConcurrentScheduler::addTask(const Task& task) {
+    SCHEDULER_STAT_SCOPE(StatOp::Add);
+    Shard& shard = shardFor(task.getId());
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.queue.contains(task.getId())) {
+        throw std::runtime_error("Task ID already exists. Please use a unique ID.");
+    }
+    shard.queue.push(task);
+    shard.publishTop();
+}
+
+bool ConcurrentScheduler::popFrom(Shard& shard, Task& task, const TakenCallback& onTaken) {
+    if (shard.queue.empty()) {
+        return false;
+    }
+    task = shard.queue.pop();
+    shard.publishTop();
+    if (onTaken) onTaken(task);
+    return true;
+}
+
+bool ConcurrentScheduler::tryRemoveHighestPriorityTask(Task& task, const TakenCallback& onTaken) {
+    SCHEDULER_STAT_SCOPE(StatOp::Pop);
+    // Relaxed pops: compare two random shards' cached tops, lock the better
+    for (size_t attempt = 0; attempt < 2 * shardCount; ++attempt) {
+        Shard& first = shards[randomShard()];
+        Shard& second = shards[randomShard()];
+        Shard& best = first.topPriority.load(std::memory_order_relaxed) <=
+                              second.topPriority.load(std::memory_order_relaxed)
+                          ? first : second;
+        if (best.topPriority.load(std::memory_order_relaxed) == EMPTY_PRIORITY) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(best.mutex, std::try_to_lock);
+        if (lock.owns_lock() && popFrom(best, task, onTaken)) {
+            return true;
+        }
+    }
+
+    // Sampling kept missing: sweep every shard before reporting empty
+    for (size_t i = 0; i < shardCount; ++i) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        if (popFrom(shards[i], task, onTaken)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ConcurrentScheduler::updateTaskPriority(int taskId, int newPriority) {
+    SCHEDULER_STAT_SCOPE(StatOp::Update);
+    Shard& shard = shardFor(taskId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (!shard.queue.updatePriority(taskId, newPriority)) {
+        throw std::runtime_error("Task not found");
+    }
+    shard.publishTop();
+}
+
+Task ConcurrentScheduler::cancelTask(int taskId, const TakenCallback& onTaken) {
+    SCHEDULER_STAT_SCOPE(StatOp::Cancel);
+    Shard& shard = shardFor(taskId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Task cancelled;
+    if (!shard.queue.remove(taskId, cancelled)) {
+        throw std::runtime_error("Task not found");
+    }
+    shard.publishTop();
+    if (onTaken) onTaken(cancelled);
+    return cancelled;
+}
+
+bool ConcurrentScheduler::isTaskIdExists(int taskId) const {
+    Shard& shard = shardFor(taskId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.queue.contains(taskId);
+}
+
+size_t ConcurrentScheduler::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < shardCount; ++i) {
+        total += shards[i].count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::vector<Task> ConcurrentScheduler::snapshot() const {
+    // Shards are copied one at a time, so the result is per-shard consistent
+    std::vector<Task> tasks;
+    for (size_t i = 0; i < shardCount; ++i) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        auto shardTasks = shards[i].queue.tasks();
+        tasks.insert(tasks.end(), std::make_move_iterator(shardTasks.begin()),
+                     std::make_move_iterator(shardTasks.end()));
+    }
+    return tasks;
+}
@@ -1,12 +1,66 @@
 #include "file_manager.hpp"
+#include "task_csv.hpp"
+#include "task_snapshot.hpp"
+#include "scheduler_stats.hpp"
 #include <filesystem>
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace fs = std::filesystem;
 
-FileManager::FileManager() {
+namespace {
+
+// Flushes a written file, or a directory's entries, to stable storage
+bool syncPath(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+}
+
+// Moves a complete temporary file over path. A crash leaves either the
+// old file or the new one, never a partial write.
+bool replaceWith(const std::string& temporary, const std::string& path, bool sync) {
+    std::error_code ec;
+    if (sync && !syncPath(temporary)) {
+        fs::remove(temporary, ec);
+        return false;
+    }
+    fs::rename(temporary, path, ec);
+    if (ec) {
+        fs::remove(temporary, ec);
+        return false;
+    }
+    if (sync) {
+        syncPath(fs::path(path).parent_path().string());
+    }
+    return true;
+}
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+FileManager::FileManager(const LoggerConfig& loggerConfig)
+    : logger(LOG_FILE, loggerConfig) {
     createDirectories();
+    if (!backupCatalog.load()) {
+        rebuildBackupCatalog();
+    }
+}
+
+FileManager::~FileManager() {
+    waitForReport();
+    waitForWrites();
 }
 
 void FileManager::createDirectories() {
@@ -23,136 +77,522 @@ std::string FileManager::getCurrentTimestamp() const {
     return ss.str();
 }
 
+const std::string& FileManager::tasksFile() const {
+    return snapshotFormat == SnapshotFormat::Binary ? TASKS_FILE : CSV_TASKS_FILE;
+}
+
+bool FileManager::writeTaskFile(const std::string& path, const std::vector<Task>& tasks) const {
+    return snapshotFormat == SnapshotFormat::Binary ? TaskSnapshot::write(path, tasks)
+                                                    : TaskCsv::write(path, tasks);
+}
+
+bool FileManager::publishTaskFile(const std::string& path, const std::vector<Task>& tasks) const {
+    std::string temporary = path + ".tmp";
+    if (!writeTaskFile(temporary, tasks)) {
+        std::error_code ec;
+        fs::remove(temporary, ec);
+        return false;
+    }
+    return replaceWith(temporary, path, syncWrites);
+}
+
+bool FileManager::publishFile(const std::string& path, const std::string& contents) const {
+    std::string temporary = path + ".tmp";
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), contents.size());
+    file.close();
+    if (!file) {
+        std::error_code ec;
+        fs::remove(temporary, ec);
+        return false;
+    }
+    return replaceWith(temporary, path, syncWrites);
+}
+
+bool FileManager::readTaskFile(const std::string& path, std::vector<Task>& tasks, std::string& error) {
+    // The format is detected from the file contents, not its name
+    if (TaskSnapshot::isSnapshotFile(path)) {
+        SnapshotLoadResult result = TaskSnapshot::load(path);
+        if (!result.error.empty()) {
+            error = path + ": " + result.error;
+            logAction("Error reading snapshot " + error);
+            return false;
+        }
+        tasks = std::move(result.tasks);
+        return true;
+    }
+
+    CsvLoadResult result = TaskCsv::load(path);
+    if (!result.errors.empty()) {
+        for (const auto& parseError : result.errors) {
+            logAction("Error parsing " + path + " line " +
+                      std::to_string(parseError.line) + ": " + parseError.message);
+        }
+        const auto& first = result.errors.front();
+        error = path + " line " + std::to_string(first.line) + ": " + first.message;
+        return false;
+    }
+    tasks = std::move(result.tasks);
+    return true;
+}
+
+void FileManager::removeOtherTasksFile() {
+    // Drop the other format's file so a stale copy is never loaded
+    const std::string& other = snapshotFormat == SnapshotFormat::Binary ? CSV_TASKS_FILE : TASKS_FILE;
+    std::error_code ec;
+    fs::remove(other, ec);
+}
+
 void FileManager::saveTasks(const std::vector<Task>& tasks) {
-    std::ofstream file(TASKS_FILE);
-    file << "TaskID,Priority,Description\n";
-    for (const auto& task : tasks) {
-        file << task.getId() << ","
-             << task.getPriority() << ","
-             << task.getDescription() << "\n";
+    // A background snapshot still in flight must not land after this one
+    writer.wait();
+    if (!publishTaskFile(tasksFile(), tasks)) {
+        throw std::runtime_error("Failed to write " + tasksFile());
     }
+    removeOtherTasksFile();
+}
+
+bool FileManager::saveTasksInBackground(std::vector<Task> tasks) {
+    if (snapshotInFlight.exchange(true, std::memory_order_acq_rel)) {
+        return false;
+    }
+    
+    // The snapshot covers every record so far; later ones go to a fresh journal
+    journal.rotate(RETIRED_JOURNAL_FILE);
+    writer.submit([this, tasks = std::move(tasks)]() {
+        if (publishTaskFile(tasksFile(), tasks)) {
+            removeOtherTasksFile();
+            std::error_code ec;
+            fs::remove(RETIRED_JOURNAL_FILE, ec);
+            logAction("Saved tasks to file in the background");
+        } else {
+            logAction("Failed to write " + tasksFile() + "; keeping the retired journal");
+        }
+        snapshotInFlight.store(false, std::memory_order_release);
+    });
+    return true;
+}
+
+void FileManager::truncateJournal() {
+    journal.truncate();
+    std::error_code ec;
+    fs::remove(RETIRED_JOURNAL_FILE, ec);
+}
+
+std::vector<JournalRecord> FileManager::loadJournal() const {
+    // Retired records predate everything in the live journal
+    std::vector<JournalRecord> records = TaskJournal::readFile(RETIRED_JOURNAL_FILE);
+    std::vector<JournalRecord> live = journal.readAll();
+    records.insert(records.end(), std::make_move_iterator(live.begin()),
+                   std::make_move_iterator(live.end()));
+    return records;
+}
+
+bool FileManager::hasRetiredJournal() const {
+    std::error_code ec;
+    return fs::exists(RETIRED_JOURNAL_FILE, ec);
 }
 
 std::vector<Task> FileManager::loadTasks() {
     std::vector<Task> tasks;
-    std::ifstream file(TASKS_FILE);
-    
-    if (!file.is_open()) return tasks;
-    
-    std::string line, header;
-    std::getline(file, header); // Skip header
-    
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string idStr, priorityStr, description;
-        
-        std::getline(ss, idStr, ',');
-        std::getline(ss, priorityStr, ',');
-        std::getline(ss, description);
-        
-        tasks.emplace_back(std::stoi(idStr), description, std::stoi(priorityStr));
+    std::string path = tasksFile();
+    if (!fs::exists(path)) {
+        path = snapshotFormat == SnapshotFormat::Binary ? CSV_TASKS_FILE : TASKS_FILE;
+        if (!fs::exists(path)) return tasks;
     }
     
+    std::string error;
+    if (!readTaskFile(path, tasks, error)) {
+        throw std::runtime_error(error);
+    }
     return tasks;
 }
 
+bool FileManager::exportCsv(const std::string& path, const std::vector<Task>& tasks) {
+    bool written = TaskCsv::write(path, tasks);
+    logAction((written ? "Exported CSV: " : "Failed to export CSV: ") + path);
+    return written;
+}
+
 void FileManager::logAction(const std::string& action, const Task& task) {
-    std::ofstream log(LOG_FILE, std::ios::app);
-    log << getCurrentTimestamp() << " - " 
-        << action << " - Task ID: " << task.getId()
-        << ", Priority: " << task.getPriority()
-        << ", Description: " << task.getDescription() << "\n";
+    SCHEDULER_STAT_SCOPE(StatOp::Log);
+    LogRecord record;
+    record.time = std::chrono::system_clock::now();
+    record.action = action;
+    record.hasTask = true;
+    record.taskId = task.getId();
+    record.priority = task.getPriority();
+    record.description = task.getDescriptionText();
+    logger.log(std::move(record));
 }
 
 void FileManager::logAction(const std::string& action) {
-    std::ofstream log(LOG_FILE, std::ios::app);
-    log << getCurrentTimestamp() << " - " << action << "\n";
+    SCHEDULER_STAT_SCOPE(StatOp::Log);
+    LogRecord record;
+    record.time = std::chrono::system_clock::now();
+    record.action = action;
+    logger.log(std::move(record));
 }
 
-void FileManager::createBackup(const std::vector<Task>& tasks) {
-    std::string backupFile = BACKUP_DIR + "backup_" + getCurrentTimestamp() + ".csv";
-    std::ofstream file(backupFile);
+namespace {
+
+std::string deltaPath(const std::string& stem, size_t sequence) {
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), "_d%04zu", sequence);
+    return stem + suffix + ".delta";
+}
+
+std::string stemOf(const std::string& path) {
+    return path.substr(0, path.size() - fs::path(path).extension().string().size());
+}
+
+}  // namespace
+
+std::string FileManager::nextBackupStem() {
+    // Milliseconds plus a counter keep names unique when several bases
+    // share one; a base still queued on the writer is not catalogued yet,
+    // so names also keep increasing past the last one issued
+    int64_t ms = nowMs();
+    char millis[8];
+    std::snprintf(millis, sizeof(millis), "_%03d", static_cast<int>(ms % 1000));
+    std::string prefix = BACKUP_DIR + "backup_" + getCurrentTimestamp() + millis;
+    for (int n = 0;; ++n) {
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), "_%03d", n);
+        std::string stem = prefix + suffix;
+        if (stem > lastBackupStem && !backupCatalog.contains(stem + ".snap") &&
+            !backupCatalog.contains(stem + ".csv")) {
+            lastBackupStem = stem;
+            return stem;
+        }
+    }
+}
+
+void FileManager::rebuildBackupCatalog() {
+    // No manifest yet: index whatever backups are already on disk, once
+    std::vector<BackupEntry> found;
+    auto clockOffset = std::chrono::system_clock::now().time_since_epoch() -
+                       fs::file_time_type::clock::now().time_since_epoch();
+    for (const auto& file : fs::directory_iterator(BACKUP_DIR)) {
+        auto extension = file.path().extension();
+        if (extension != ".snap" && extension != ".csv" && extension != ".delta") continue;
+
+        BackupEntry entry;
+        entry.path = file.path().string();
+        if (!BackupCatalog::checksumFile(entry.path, entry.checksum, entry.bytes)) continue;
+        auto written = file.last_write_time().time_since_epoch() + clockOffset;
+        entry.createdMs = std::chrono::duration_cast<std::chrono::milliseconds>(written).count();
+        if (extension == ".delta") {
+            std::ifstream delta(entry.path, std::ios::binary);
+            std::stringstream contents;
+            contents << delta.rdbuf();
+            entry.taskCount = TaskJournal::parseRecords(contents.str()).size();
+        } else {
+            std::vector<Task> tasks;
+            std::string error;
+            if (!readTaskFile(entry.path, tasks, error)) continue;
+            entry.taskCount = tasks.size();
+        }
+        found.push_back(std::move(entry));
+    }
+    backupCatalog.rebuild(std::move(found));
+    logAction("Indexed " + std::to_string(backupCatalog.size()) + " existing backups");
+}
+
+bool FileManager::matchesCatalog(const std::string& path, uint64_t checksum, uint64_t bytes,
+                                 std::string& error) const {
+    BackupEntry entry;
+    if (!backupCatalog.find(path, entry)) return true;  // Nothing recorded to check against
+    if (entry.checksum != checksum || entry.bytes != bytes) {
+        error = path + ": contents do not match the backup catalog";
+        return false;
+    }
+    return true;
+}
+
+void FileManager::catalogBackup(const std::string& path, int64_t createdMs, uint64_t taskCount) {
+    BackupEntry entry;
+    entry.path = path;
+    entry.createdMs = createdMs;
+    entry.taskCount = taskCount;
+    if (!BackupCatalog::checksumFile(path, entry.checksum, entry.bytes)) {
+        logAction("Failed to read back " + path + " for the backup catalog");
+        return;
+    }
+    backupCatalog.add(std::move(entry));
+}
+
+void FileManager::pruneBackups(int64_t protectFromMs) {
+    // The catalog forgets a backup before its file goes, so a crash in
+    // between leaves an unlisted file rather than a listed missing one
+    std::vector<std::string> expired = backupCatalog.expired(backupRetention, protectFromMs);
+    std::error_code ec;
+    for (const auto& path : expired) {
+        backupCatalog.remove(path);
+        fs::remove(path, ec);
+    }
+    if (!expired.empty()) {
+        logAction("Retention removed " + std::to_string(expired.size()) + " old backups");
+    }
+}
+
+void FileManager::createBackup(std::vector<Task> tasks) {
+    SCHEDULER_STAT_SCOPE(StatOp::Backup);
+    std::string extension = snapshotFormat == SnapshotFormat::Binary ? ".snap" : ".csv";
+    std::string backupFile = nextBackupStem() + extension;
+    int64_t createdMs = nowMs();
+    writer.submit([this, backupFile, createdMs, tasks = std::move(tasks)]() {
+        if (publishTaskFile(backupFile, tasks)) {
+            catalogBackup(backupFile, createdMs, tasks.size());
+            logAction("Created backup: " + backupFile);
+        } else {
+            backupChainBroken.store(true);  // Deltas must not build on it
+            logAction("Failed to write backup: " + backupFile);
+        }
+    });
     
-    file << "TaskID,Priority,Description\n";
-    for (const auto& task : tasks) {
-        file << task.getId() << ","
-             << task.getPriority() << ","
-             << task.getDescription() << "\n";
+    // Start a new chain, fold the previous one into a single file and thin
+    // out old backups. The hand-off is queued behind the chain's last delta,
+    // and the rest runs on its own thread so it does not hold up later writes
+    std::string previousBase = backupBase;
+    bool compactPrevious = !previousBase.empty() && backupDeltaCount > 0;
+    backupBase = backupFile;
+    backupDeltaCount = 0;
+    backupChainOpen = true;
+    backupChainBroken.store(false);
+    writer.submit([this, previousBase, compactPrevious, createdMs]() {
+        compactor.submit([this, previousBase, compactPrevious, createdMs]() {
+            if (compactPrevious) compactBackupChain(previousBase);
+            pruneBackups(createdMs);  // The new base and anything after it stay
+        });
+    });
+}
+
+bool FileManager::createIncrementalBackup(const std::vector<JournalRecord>& delta) {
+    SCHEDULER_STAT_SCOPE(StatOp::Backup);
+    if (!backupChainOpen || backupChainBroken.load()) {
+        return false;  // No base to build on yet
     }
     
-    logAction("Created backup: " + backupFile);
+    std::string backupFile = deltaPath(stemOf(backupBase), backupDeltaCount + 1);
+    std::string contents = "# delta " + std::to_string(backupDeltaCount + 1) + " of " +
+                           fs::path(backupBase).filename().string() + "\n";
+    for (const auto& record : delta) {
+        TaskJournal::formatRecord(contents, record);
+    }
+    
+    BackupEntry entry;
+    entry.path = backupFile;
+    entry.createdMs = nowMs();
+    entry.bytes = contents.size();
+    entry.taskCount = delta.size();
+    entry.checksum = BackupCatalog::checksum(contents);
+    ++backupDeltaCount;
+    writer.submit([this, entry = std::move(entry), contents = std::move(contents)]() mutable {
+        const std::string backupFile = entry.path;
+        if (publishFile(backupFile, contents)) {
+            backupCatalog.add(std::move(entry));
+            logAction("Created incremental backup: " + backupFile);
+        } else {
+            backupChainBroken.store(true);  // Later deltas would leave a gap
+            logAction("Failed to write incremental backup: " + backupFile);
+        }
+    });
+    return true;
 }
 
-void FileManager::generateReport(const std::vector<Task>& tasks,
-                               const std::vector<Task>& completedTasks) {
-    std::string reportFile = REPORT_DIR + "report_" + getCurrentTimestamp() + ".html";
-    std::ofstream file(reportFile);
+void FileManager::resetBackupChain() {
+    // The closed chain is still compacted when the next base is written
+    backupChainOpen = false;
+}
+
+void FileManager::applyDelta(std::vector<Task>& tasks, const std::vector<JournalRecord>& records) {
+    std::unordered_map<int, size_t> index;
+    index.reserve(tasks.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        index[tasks[i].getId()] = i;
+    }
     
-    file << "<!DOCTYPE html>\n<html>\n<head>\n"
-         << "<style>\n"
-         << "body { font-family: Arial, sans-serif; margin: 40px; }\n"
-         << "table { border-collapse: collapse; width: 100%; }\n"
-         << "th, td { border: 1px solid #ddd; padding: 8px; text-align: left; }\n"
-         << "th { background-color: #4CAF50; color: white; }\n"
-         << "tr:nth-child(even) { background-color: #f2f2f2; }\n"
-         << ".summary { margin-bottom: 20px; }\n"
-         << "</style>\n"
-         << "</head>\n<body>\n";
+    for (const auto& record : records) {
+        auto it = index.find(record.taskId);
+        switch (record.op) {
+            case JournalOp::Add:
+                if (it == index.end()) {
+                    index[record.taskId] = tasks.size();
+                    tasks.emplace_back(record.taskId, record.description, record.priority);
+                    tasks.back().setNotBefore(record.notBefore);
+                    tasks.back().setDeadline(record.deadline);
+                }
+                break;
+            case JournalOp::Update:
+                if (it != index.end()) {
+                    tasks[it->second].setPriority(record.priority);
+                }
+                break;
+            case JournalOp::Execute:
+            case JournalOp::Cancel:
+                if (it != index.end()) {
+                    // Swap with the last task so removal stays O(1)
+                    size_t slot = it->second;
+                    index.erase(it);
+                    if (slot != tasks.size() - 1) {
+                        tasks[slot] = std::move(tasks.back());
+                        index[tasks[slot].getId()] = slot;
+                    }
+                    tasks.pop_back();
+                }
+                break;
+        }
+    }
+}
+
+bool FileManager::loadBackupChain(const std::string& deltaFile, std::vector<Task>& tasks, std::string& error) {
+    // "<base stem>_dNNNN.delta" -> base stem and delta sequence
+    std::string deltaStem = stemOf(deltaFile);
+    size_t marker = deltaStem.rfind("_d");
+    if (marker == std::string::npos) {
+        error = deltaFile + ": not an incremental backup name";
+        return false;
+    }
+    std::string baseStem = deltaStem.substr(0, marker);
+    size_t lastSequence = 0;
+    try {
+        lastSequence = std::stoul(deltaStem.substr(marker + 2));
+    } catch (const std::exception&) {
+        error = deltaFile + ": not an incremental backup name";
+        return false;
+    }
     
-    // Summary Section
-    file << "<div class='summary'>\n"
-         << "<h2>Task Scheduler Report - " << getCurrentTimestamp() << "</h2>\n"
-         << "<p>Total Active Tasks: " << tasks.size() << "</p>\n"
-         << "<p>Total Completed Tasks: " << completedTasks.size() << "</p>\n"
-         << "</div>\n";
+    std::string basePath = fs::exists(baseStem + ".snap") ? baseStem + ".snap" : baseStem + ".csv";
+    if (!fs::exists(basePath)) {
+        error = deltaFile + ": base backup " + basePath + " is missing";
+        return false;
+    }
+    uint64_t checksum = 0;
+    uint64_t bytes = 0;
+    if (!BackupCatalog::checksumFile(basePath, checksum, bytes) ||
+        !matchesCatalog(basePath, checksum, bytes, error) || !readTaskFile(basePath, tasks, error)) {
+        if (error.empty()) error = basePath + ": cannot be read";
+        return false;
+    }
     
-    // Active Tasks Table
-    file << "<h3>Active Tasks</h3>\n"
-         << "<table>\n"
-         << "<tr><th>ID</th><th>Priority</th><th>Description</th></tr>\n";
+    for (size_t sequence = 1; sequence <= lastSequence; ++sequence) {
+        std::string path = deltaPath(baseStem, sequence);
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            error = path + ": delta is missing from the chain";
+            return false;
+        }
+        std::stringstream contents;
+        contents << file.rdbuf();
+        std::string text = contents.str();
+        if (!matchesCatalog(path, BackupCatalog::checksum(text), text.size(), error)) {
+            return false;
+        }
+        applyDelta(tasks, TaskJournal::parseRecords(text));
+    }
+    return true;
+}
+
+void FileManager::compactBackupChain(const std::string& basePath) {
+    std::string baseStem = stemOf(basePath);
+    size_t lastSequence = 0;
+    while (backupCatalog.contains(deltaPath(baseStem, lastSequence + 1))) {
+        ++lastSequence;
+    }
+    if (lastSequence == 0) return;
     
-    for (const auto& task : tasks) {
-        file << "<tr><td>" << task.getId() << "</td>"
-             << "<td>" << task.getPriority() << "</td>"
-             << "<td>" << task.getDescription() << "</td></tr>\n";
+    std::vector<Task> tasks;
+    std::string error;
+    std::string lastDelta = deltaPath(baseStem, lastSequence);
+    if (!loadBackupChain(lastDelta, tasks, error)) {
+        logAction("Backup compaction skipped: " + error);
+        return;
     }
     
-    file << "</table>\n";
+    // The chain's final state replaces its base, keeping the name taken
+    std::string extension = snapshotFormat == SnapshotFormat::Binary ? ".snap" : ".csv";
+    std::string compacted = baseStem + extension;
+    if (!publishTaskFile(compacted, tasks)) {
+        logAction("Backup compaction failed to write " + compacted);
+        return;
+    }
     
-    // Completed Tasks Table
-    file << "<h3>Recently Completed Tasks</h3>\n"
-         << "<table>\n"
-         << "<tr><th>ID</th><th>Priority</th><th>Description</th></tr>\n";
+    // The compacted file holds the state as of the last delta
+    BackupEntry last;
+    backupCatalog.find(lastDelta, last);
+    catalogBackup(compacted, last.createdMs, tasks.size());
     
-    for (const auto& task : completedTasks) {
-        file << "<tr><td>" << task.getId() << "</td>"
-             << "<td>" << task.getPriority() << "</td>"
-             << "<td>" << task.getDescription() << "</td></tr>\n";
+    std::error_code ec;
+    if (compacted != basePath) {
+        backupCatalog.remove(basePath);
+        fs::remove(basePath, ec);
     }
+    for (size_t sequence = 1; sequence <= lastSequence; ++sequence) {
+        std::string path = deltaPath(baseStem, sequence);
+        backupCatalog.remove(path);
+        fs::remove(path, ec);
+    }
+    logAction("Compacted backup chain into " + compacted);
+}
+
+std::string FileManager::generateReport(std::vector<Task> tasks, std::vector<CompletedTask> recentCompleted) {
+    ReportData data;
+    data.timestamp = getCurrentTimestamp();
+    data.tasks = std::move(tasks);
+    data.recentCompleted = std::move(recentCompleted);
+    data.stats = SchedulerStats::snapshot();
     
-    file << "</table>\n</body>\n</html>";
+    // Milliseconds plus a counter, so reports in the same second never
+    // overwrite each other's pages
+    int64_t ms = nowMs();
+    char millis[8];
+    std::snprintf(millis, sizeof(millis), "_%03d", static_cast<int>(ms % 1000));
+    std::string prefix = REPORT_DIR + "report_" + data.timestamp + millis;
+    std::string stem;
+    for (int n = 0;; ++n) {
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), "_%03d", n);
+        stem = prefix + suffix;
+        if (stem > lastReportStem && !fs::exists(stem + ".html")) break;
+    }
+    lastReportStem = stem;
     
-    logAction("Generated report: " + reportFile);
+    // The archive is summarized on the report thread; later appends only add
+    // whole blocks past the end it maps
+    history.flush();
+    reporter.submit([this, stem, config = reportConfig, data = std::move(data)]() mutable {
+        data.archivedHistory = HistoryArchive::summarize(HISTORY_FILE);
+        if (TaskReport::write(stem, data, config)) {
+            logAction("Generated report: " + stem + ".html");
+        } else {
+            logAction("Failed to write report: " + stem + ".html");
+        }
+    });
+    return stem + ".html";
+}
+
+void FileManager::waitForReport() {
+    reporter.wait();
+}
+
+std::vector<BackupEntry> FileManager::listBackups() {
+    waitForWrites();  // List backups only once queued ones are on disk
+    return backupCatalog.list();
 }
 
-std::vector<std::string> FileManager::getBackupFiles() const {
+std::vector<std::string> FileManager::getBackupFiles() {
     std::vector<std::string> backups;
-    for (const auto& entry : fs::directory_iterator(BACKUP_DIR)) {
-        if (entry.path().extension() == ".csv") {
-            backups.push_back(entry.path().string());
-        }
+    for (auto& entry : listBackups()) {
+        backups.push_back(std::move(entry.path));
     }
-    // Sort by filename (which contains timestamp) in descending order
-    std::sort(backups.begin(), backups.end(), std::greater<std::string>());
     return backups;
 }
 
-std::string FileManager::getLatestBackupFile() const {
-    auto backups = getBackupFiles();
-    if (backups.empty()) {
-        return "";
-    }
-    return backups[0]; // Return the most recent backup
+std::string FileManager::getLatestBackupFile() {
+    waitForWrites();
+    BackupEntry latest;
+    return backupCatalog.latest(latest) ? latest.path : "";
 }
 
 bool FileManager::restoreFromBackup(const std::string& backupFile, std::vector<Task>& tasks) {
@@ -160,33 +600,22 @@ bool FileManager::restoreFromBackup(const std::string& backupFile, std::vector<T
         return false;
     }
 
-    std::ifstream file(backupFile);
-    if (!file.is_open()) {
-        return false;
+    std::string error;
+    bool loaded = false;
+    if (fs::path(backupFile).extension() == ".delta") {
+        loaded = loadBackupChain(backupFile, tasks, error);
+    } else {
+        uint64_t checksum = 0;
+        uint64_t bytes = 0;
+        loaded = BackupCatalog::checksumFile(backupFile, checksum, bytes) &&
+                 matchesCatalog(backupFile, checksum, bytes, error) &&
+                 readTaskFile(backupFile, tasks, error);
+        if (!loaded && error.empty()) error = backupFile + ": cannot be read";
     }
-
-    tasks.clear(); // Clear existing tasks
-    std::string line, header;
-    std::getline(file, header); // Skip header
-
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string idStr, priorityStr, description;
-        
-        std::getline(ss, idStr, ',');
-        std::getline(ss, priorityStr, ',');
-        std::getline(ss, description);
-        
-        try {
-            int id = std::stoi(idStr);
-            int priority = std::stoi(priorityStr);
-            tasks.emplace_back(id, description, priority);
-        } catch (const std::exception& e) {
-            logAction("Error parsing backup file: " + std::string(e.what()));
-            return false;
-        }
+    if (!loaded) {
+        logAction("Error restoring backup " + error);
+        return false;
     }
-
     logAction("Successfully restored from backup: " + backupFile);
     return true;
 }
\ No newline at end of file
@@ -1,124 +1,427 @@
 #include "min_heap.hpp"
 #include "file_manager.hpp"
 #include "task.hpp"
+#include "binary_heap_queue.hpp"
+#include "bucket_queue.hpp"
+#include "dary_heap_queue.hpp"
+#include "pairing_heap_queue.hpp"
+#include "scheduler_stats.hpp"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
-void MinHeap::heapifyUp(int index) {
-    while (index > 0) {
-        int parentIndex = getParentIndex(index);
-        if (heap[parentIndex] > heap[index]) {
-            std::swap(heap[index], heap[parentIndex]);
-            index = parentIndex;
-        } else {
-            break;
+namespace {
+
+const size_t AUTO_BACKUP_COMPLETIONS = 5;
+
+template <int Arity>
+std::unique_ptr<TaskQueue> makeDaryQueue(const SchedulerConfig& config) {
+    if (config.fifoTies) return std::make_unique<DaryHeapQueue<Arity, MinFirst, FifoTieBreak>>();
+    return std::make_unique<DaryHeapQueue<Arity>>();
+}
+
+std::unique_ptr<TaskQueue> makeQueue(const SchedulerConfig& config) {
+    if (config.agingInterval != 0 && config.engine != QueueEngine::BinaryHeap) {
+        throw std::invalid_argument("Priority aging is only supported by the binary heap engine");
+    }
+    // The bucket queue is FIFO within a priority already
+    if (config.fifoTies && config.engine != QueueEngine::DaryHeap && config.engine != QueueEngine::BucketQueue) {
+        throw std::invalid_argument("FIFO tie-breaking needs the d-ary heap or bucket queue engine");
+    }
+    switch (config.engine) {
+        case QueueEngine::BucketQueue:
+            return std::make_unique<BucketQueue>(config.minPriority, config.maxPriority);
+        case QueueEngine::DaryHeap:
+            if (config.heapArity == 4) return makeDaryQueue<4>(config);
+            if (config.heapArity == 8) return makeDaryQueue<8>(config);
+            throw std::invalid_argument("Unsupported heap arity: " + std::to_string(config.heapArity));
+        case QueueEngine::PairingHeap:
+            return std::make_unique<PairingHeapQueue>();
+        case QueueEngine::BinaryHeap:
+        default:
+            return std::make_unique<BinaryHeapQueue>(config.agingInterval);
+    }
+}
+
+}  // namespace
+
+MinHeap::MinHeap(const SchedulerConfig& schedulerConfig)
+    : queue(makeQueue(schedulerConfig)),
+      fileManager(schedulerConfig.logging),
+      config(schedulerConfig),
+      timers(schedulerConfig.timerTickMs, currentTimeMs()),
+      completed(schedulerConfig.historyCapacity) {
+    fileManager.setJournalGroupSize(config.journalGroupSize);
+    fileManager.setSyncWrites(config.syncWrites);
+    fileManager.setHistoryBatchSize(config.historyArchiveBatch);
+    fileManager.setSnapshotFormat(config.snapshotFormat);
+    fileManager.setBackupRetention(config.backupRetention);
+    fileManager.setReportConfig(config.reporting);
+}
+
+MinHeap::~MinHeap() {
+    // Changes a slower snapshot trigger left pending are not lost on a clean exit
+    if (config.persistence == PersistenceMode::Snapshot && changesSinceSnapshot > 0) {
+        try {
+            saveToFile();
+        } catch (const std::exception& e) {
+            fileManager.logAction("Final snapshot failed: " + std::string(e.what()));
         }
     }
+    // The ring only lives in memory; archive it so no completion is lost
+    for (auto& entry : completed.recent()) {
+        fileManager.archiveCompleted(std::move(entry));
+    }
+}
+
+int64_t MinHeap::currentTimeMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+JournalRecord MinHeap::addRecord(const Task& task) {
+    return {JournalOp::Add, task.getId(), task.getPriority(), task.getDescriptionText(),
+            task.getNotBefore(), task.getDeadline()};
 }
 
-void MinHeap::heapifyDown(int index) {
-    int smallestIndex = index;
-    int leftChild = getLeftChildIndex(index);
-    int rightChild = getRightChildIndex(index);
+std::vector<Task> MinHeap::allTasks() const {
+    std::vector<Task> tasks = queue->tasks();
+    if (timers.pendingCount() > 0) {
+        std::vector<Task> delayed = timers.pendingTasks();
+        tasks.insert(tasks.end(), std::make_move_iterator(delayed.begin()),
+                     std::make_move_iterator(delayed.end()));
+    }
+    return tasks;
+}
+
+void MinHeap::insertTask(Task task) {
+    // Check if task ID already exists
+    if (isTaskIdExists(task.getId())) {
+        throw std::runtime_error("Task ID already exists. Please use a unique ID.");
+    }
     
-    if (leftChild < heap.size() && heap[leftChild].getPriority() < heap[smallestIndex].getPriority()) {
-        smallestIndex = leftChild;
+    if (task.getDeadline() != 0) {
+        timers.scheduleDeadline(task);
+    }
+    // A task that is not yet eligible waits in the timing wheel instead
+    if (task.getNotBefore() == 0 || !timers.scheduleRelease(task)) {
+        queue->push(std::move(task));
+    }
+}
+
+void MinHeap::insertTasks(std::vector<Task>&& tasks, bool meld) {
+    // Validate the whole batch before touching the queue
+    std::vector<int> ids;
+    ids.reserve(tasks.size());
+    for (const auto& task : tasks) {
+        ids.push_back(task.getId());
+    }
+    std::sort(ids.begin(), ids.end());
+    if (std::adjacent_find(ids.begin(), ids.end()) != ids.end()) {
+        throw std::runtime_error("Task ID already exists. Please use a unique ID.");
+    }
+    if (!queue->empty() || timers.pendingCount() > 0) {
+        for (int id : ids) {
+            if (isTaskIdExists(id)) {
+                throw std::runtime_error("Task ID already exists. Please use a unique ID.");
+            }
+        }
     }
     
-    if (rightChild < heap.size() && heap[rightChild].getPriority() < heap[smallestIndex].getPriority()) {
-        smallestIndex = rightChild;
+    // Delayed tasks go to the wheel; the rest are built into the queue at once
+    size_t ready = 0;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (tasks[i].getDeadline() != 0) {
+            timers.scheduleDeadline(tasks[i]);
+        }
+        if (tasks[i].getNotBefore() != 0 && timers.scheduleRelease(tasks[i])) {
+            continue;
+        }
+        if (ready != i) {
+            tasks[ready] = std::move(tasks[i]);
+        }
+        ++ready;
     }
+    tasks.resize(ready);
     
-    if (smallestIndex != index) {
-        std::swap(heap[index], heap[smallestIndex]);
-        heapifyDown(smallestIndex);
+    if (meld && !queue->empty()) {
+        // Built into an engine of the same kind and merged, which the
+        // pairing heap does by melding in O(1)
+        std::unique_ptr<TaskQueue> incoming = makeQueue(config);
+        incoming->pushBatch(std::move(tasks));
+        queue->merge(*incoming);
+    } else {
+        queue->pushBatch(std::move(tasks));
+    }
+}
+
+void MinHeap::addTasks(std::vector<Task>&& tasks) {
+    std::vector<JournalRecord> records;
+    records.reserve(tasks.size());
+    for (const auto& task : tasks) {
+        records.push_back(addRecord(task));
+    }
+    insertTasks(std::move(tasks));
+    for (const auto& record : records) {
+        recordMutation(record);
     }
 }
 
 void MinHeap::addTask(const Task& task) {
-    // Check if task ID already exists
-    if (isTaskIdExists(task.getId())) {
-        throw std::runtime_error("Task ID already exists. Please use a unique ID.");
+    addTask(Task(task));
+}
+
+void MinHeap::addTask(Task&& task) {
+    SCHEDULER_STAT_SCOPE(StatOp::Add);
+    JournalRecord record = addRecord(task);
+    insertTask(std::move(task));
+    recordMutation(record);
+}
+
+void MinHeap::recordMutation(const JournalRecord& record) {
+    // Every change also feeds the next incremental backup
+    if (config.incrementalBackups) {
+        if (backupDelta.size() < config.maxBackupDeltaRecords) {
+            backupDelta.push_back(record);
+        } else {
+            backupDelta.clear();
+            fileManager.resetBackupChain();  // Next backup is a full base
+        }
+    }
+    
+    if (config.persistence != PersistenceMode::Journal) return;
+    
+    fileManager.appendJournal(record);
+    
+    // Fold the journal into a fresh snapshot once it grows too large; if
+    // one is still being written the next record tries again
+    if (fileManager.journalSize() > config.journalCompactBytes) {
+        snapshotInBackground();
+    }
+}
+
+void MinHeap::saveSnapshotIfNeeded(size_t changes) {
+    if (config.persistence != PersistenceMode::Snapshot) return;
+    changesSinceSnapshot += changes;
+    if (batching) {
+        snapshotPending = true;  // Considered once by endBatch
+    } else {
+        snapshotIfDue();
+    }
+}
+
+void MinHeap::snapshotIfDue() {
+    if (changesSinceSnapshot == 0) return;
+    switch (config.snapshotTrigger) {
+        case SnapshotTrigger::EveryChange:
+            break;
+        case SnapshotTrigger::EveryN:
+            if (changesSinceSnapshot < config.snapshotEveryChanges) return;
+            break;
+        case SnapshotTrigger::Interval:
+            if (currentTimeMs() - lastSnapshotMs < config.snapshotIntervalMs) return;
+            break;
+    }
+    snapshotInBackground();
+}
+
+bool MinHeap::snapshotInBackground() {
+    // Checked before copying: under EveryChange every mutation made during
+    // a long write gets here, and only this thread starts snapshots
+    if (fileManager.snapshotInProgress()) {
+        return false;  // Previous snapshot still in flight; changes stay pending
+    }
+    SCHEDULER_STAT_SCOPE(StatOp::Save);
+    // The copy is the only part on this thread; changes made while it is
+    // written land in the fresh journal and are picked up by the next one
+    if (!fileManager.saveTasksInBackground(allTasks())) {
+        return false;
+    }
+    changesSinceSnapshot = 0;
+    lastSnapshotMs = currentTimeMs();
+    return true;
+}
+
+void MinHeap::beginBatch() {
+    batching = true;
+    // Journal records gather until endBatch writes them as one group
+    fileManager.setJournalGroupSize(std::numeric_limits<size_t>::max());
+}
+
+void MinHeap::endBatch() {
+    batching = false;
+    fileManager.setJournalGroupSize(config.journalGroupSize);
+    if (snapshotPending) {
+        snapshotPending = false;
+        snapshotIfDue();
+    }
+    fileManager.flushJournal();
+    if (backupPending) {
+        backupPending = false;
+        createAutomaticBackup();
+    }
+}
+
+void MinHeap::releaseDueTimers() {
+    if (timers.pendingCount() > 0 || timers.deadlineCount() > 0) {
+        advanceTimers();
     }
+}
+
+Task MinHeap::takeTop() {
+    Task task = queue->pop();
+    timers.cancelDeadline(task.getId());
     
-    heap.push_back(task);
-    existingTaskIds.insert(task.getId());  // Add to tracking set
-    heapifyUp(heap.size() - 1);
+    // Add to completed tasks history; the entry it displaces is archived
+    CompletedTask evicted;
+    if (completed.push({task, currentTimeMs()}, evicted)) {
+        fileManager.archiveCompleted(std::move(evicted));
+    }
+    return task;
+}
+
+void MinHeap::countCompletions(size_t count) {
+    // Create automatic backup after every 5 tasks are completed; a batch
+    // crossing the mark more than once still takes a single backup
+    completedSinceBackup += count;
+    if (completedSinceBackup < AUTO_BACKUP_COMPLETIONS) return;
+    completedSinceBackup %= AUTO_BACKUP_COMPLETIONS;
+    if (batching) {
+        backupPending = true;
+    } else {
+        createAutomaticBackup();
+    }
 }
 
 Task MinHeap::removeHighestPriorityTask() {
-    if (heap.empty()) {
+    SCHEDULER_STAT_SCOPE(StatOp::Pop);
+    releaseDueTimers();
+    if (queue->empty()) {
         fileManager.logAction("Attempted to remove task from empty heap");
         throw std::runtime_error("Heap is empty");
     }
     
-    // Store the highest priority task
-    Task highestPriorityTask = heap[0];
+    Task highestPriorityTask = takeTop();
     
-    // Remove the task ID from tracking set
-    existingTaskIds.erase(highestPriorityTask.getId());
-    
-    // Replace root with last element and remove last element
-    heap[0] = heap.back();
-    heap.pop_back();
+    // Log the task execution
+    fileManager.logAction("Executed task", highestPriorityTask);
     
-    // Rebalance the heap if not empty
-    if (!heap.empty()) {
-        heapifyDown(0);
-    }
+    // Persist the removal: one journal record, or a full snapshot
+    recordMutation({JournalOp::Execute, highestPriorityTask.getId(), 0, {}});
+    saveSnapshotIfNeeded();
+    countCompletions(1);
     
-    // Add to completed tasks history
-    completedTasks.push_back(highestPriorityTask);
+    return highestPriorityTask;
+}
+
+std::vector<Task> MinHeap::removeTopK(size_t k) {
+    SCHEDULER_STAT_SCOPE(StatOp::Pop);
+    releaseDueTimers();
     
-    // Keep only the last 10 completed tasks
-    if (completedTasks.size() > 10) {
-        completedTasks.erase(completedTasks.begin());
+    std::vector<Task> executed;
+    executed.reserve(std::min(k, queue->size()));
+    while (executed.size() < k && !queue->empty()) {
+        executed.push_back(takeTop());
     }
+    recordExecuted(executed);
+    return executed;
+}
+
+std::vector<Task> MinHeap::drainUntil(int priorityThreshold) {
+    SCHEDULER_STAT_SCOPE(StatOp::Pop);
+    // An aged task can sit above fresher ones of lower raw priority, so the
+    // first top over the threshold would not mean the rest are over it too
+    if (config.agingInterval != 0) {
+        throw std::logic_error("drainUntil is not available while priority aging is on");
+    }
+    releaseDueTimers();
     
-    // Log the task execution
-    fileManager.logAction("Executed task", highestPriorityTask);
+    // The count is unknown until the first task above the threshold is seen
+    std::vector<Task> executed;
+    while (!queue->empty() && queue->top().getPriority() <= priorityThreshold) {
+        executed.push_back(takeTop());
+    }
+    recordExecuted(executed);
+    return executed;
+}
+
+void MinHeap::recordExecuted(const std::vector<Task>& executed) {
+    if (executed.empty()) return;
     
-    // Save the current state to file
-    saveToFile();
+    // One journal write, one snapshot and one backup decision for the batch,
+    // unless the caller's own batch already defers them
+    bool ownBatch = !batching;
+    if (ownBatch) beginBatch();
     
-    // Create automatic backup after every 5 tasks are completed
-    static int completedCount = 0;
-    completedCount++;
-    if (completedCount % 5 == 0) {
-        fileManager.createBackup(heap);
-        fileManager.logAction("Created automatic backup after 5 task completions");
+    int lowest = executed.front().getPriority();
+    int highest = lowest;
+    for (const auto& task : executed) {
+        recordMutation({JournalOp::Execute, task.getId(), 0, {}});
+        lowest = std::min(lowest, task.getPriority());
+        highest = std::max(highest, task.getPriority());
     }
+    saveSnapshotIfNeeded(executed.size());
+    countCompletions(executed.size());
     
-    return highestPriorityTask;
+    fileManager.logAction("Executed " + std::to_string(executed.size()) + " tasks, priorities " +
+                          std::to_string(lowest) + " to " + std::to_string(highest));
+    
+    if (ownBatch) endBatch();
 }
 
 
-int MinHeap::findTaskIndex(int taskId) const {
-    for (size_t i = 0; i < heap.size(); ++i) {
-        if (heap[i].getId() == taskId) {
-            return i;
-        }
+void MinHeap::updateTaskPriority(int taskId, int newPriority) {
+    SCHEDULER_STAT_SCOPE(StatOp::Update);
+    bool queued = queue->updatePriority(taskId, newPriority);
+    if (!timers.updatePriority(taskId, newPriority) && !queued) {
+        throw std::runtime_error("Task not found");
     }
-    return -1;
+    
+    recordMutation({JournalOp::Update, taskId, newPriority, {}});
 }
 
-void MinHeap::updateTaskPriority(int taskId, int newPriority) {
-    int index = findTaskIndex(taskId);
-    if (index == -1) {
+Task MinHeap::cancelTask(int taskId) {
+    SCHEDULER_STAT_SCOPE(StatOp::Cancel);
+    Task cancelledTask;
+    if (!queue->remove(taskId, cancelledTask) && !timers.cancelRelease(taskId, cancelledTask)) {
         throw std::runtime_error("Task not found");
     }
+    timers.cancelDeadline(taskId);
     
-    int oldPriority = heap[index].getPriority();
-    heap[index].setPriority(newPriority);
+    fileManager.logAction("Cancelled task", cancelledTask);
+    recordMutation({JournalOp::Cancel, taskId, 0, {}});
+    saveSnapshotIfNeeded();
+    return cancelledTask;
+}
+
+size_t MinHeap::advanceTimers(int64_t nowMs) {
+    std::vector<Task> released;
+    std::vector<Task> expired;
+    timers.advance(nowMs, released, expired);
     
-    if (newPriority < oldPriority) {
-        heapifyUp(index);
-    } else {
-        heapifyDown(index);
+    size_t count = released.size();
+    if (count > 0) {
+        queue->pushBatch(std::move(released));
+        fileManager.logAction("Released " + std::to_string(count) + " delayed tasks");
+    }
+    for (const auto& task : expired) {
+        fileManager.logAction("Deadline expired", task);
+        if (deadlineCallback) {
+            deadlineCallback(task);
+        }
     }
+    // Interval snapshots, and ones skipped while a write was in flight,
+    // come due here even when no further change arrives
+    if (!batching && config.persistence == PersistenceMode::Snapshot) {
+        snapshotIfDue();
+    }
+    return count;
 }
 
 void MinHeap::displayTasks() const {
-    if (heap.empty()) {
+    if (queue->empty() && timers.pendingCount() == 0) {
         std::cout << "No tasks in the scheduler.\n";
         return;
     }
@@ -127,36 +430,118 @@ void MinHeap::displayTasks() const {
     std::cout << "ID\tPriority\tDescription\n";
     std::cout << "--------------------------------\n";
     
-    for (const auto& task : heap) {
+    for (const auto& task : queue->tasks()) {
         std::cout << task.getId() << "\t" 
                   << task.getPriority() << "\t\t"
                   << task.getDescription() << "\n";
     }
     std::cout << "--------------------------------\n";
+    
+    if (timers.pendingCount() > 0) {
+        int64_t now = currentTimeMs();
+        std::cout << "\nDelayed Tasks:\n";
+        std::cout << "ID\tPriority\tEligible In (s)\tDescription\n";
+        std::cout << "--------------------------------\n";
+        for (const auto& task : timers.pendingTasks()) {
+            std::cout << task.getId() << "\t"
+                      << task.getPriority() << "\t\t"
+                      << std::max<int64_t>(0, (task.getNotBefore() - now + 999) / 1000) << "\t\t"
+                      << task.getDescription() << "\n";
+        }
+        std::cout << "--------------------------------\n";
+    }
 }
 
 void MinHeap::loadFromFile() {
-    auto tasks = fileManager.loadTasks();
-    for (const auto& task : tasks) {
-        addTask(task);
+    SCHEDULER_STAT_SCOPE(StatOp::Load);
+    insertTasks(fileManager.loadTasks());
+    replayJournal();
+    
+    // A retired journal means the last background snapshot never landed;
+    // fold it into a durable one now
+    if (fileManager.hasRetiredJournal()) {
+        saveToFile();
     }
+    
+    // Backups taken before this load no longer describe the queue
+    backupDelta.clear();
+    fileManager.resetBackupChain();
     fileManager.logAction("Loaded tasks from file");
 }
 
+void MinHeap::replayJournal() {
+    // Records are applied idempotently: a crash between writing a snapshot
+    // and truncating the journal leaves records the snapshot already covers.
+    auto records = fileManager.loadJournal();
+    for (const auto& record : records) {
+        Task removed;
+        switch (record.op) {
+            case JournalOp::Add:
+                if (!isTaskIdExists(record.taskId)) {
+                    Task task(record.taskId, record.description, record.priority);
+                    task.setNotBefore(record.notBefore);
+                    task.setDeadline(record.deadline);
+                    insertTask(task);
+                }
+                break;
+            case JournalOp::Update:
+                queue->updatePriority(record.taskId, record.priority);
+                timers.updatePriority(record.taskId, record.priority);
+                break;
+            case JournalOp::Execute:
+            case JournalOp::Cancel:
+                if (!queue->remove(record.taskId, removed)) {
+                    timers.cancelRelease(record.taskId, removed);
+                }
+                timers.cancelDeadline(record.taskId);
+                break;
+        }
+    }
+    if (!records.empty()) {
+        fileManager.logAction("Replayed " + std::to_string(records.size()) + " journal records");
+    }
+}
+
 void MinHeap::saveToFile() {
-    fileManager.saveTasks(heap);
+    SCHEDULER_STAT_SCOPE(StatOp::Save);
+    fileManager.saveTasks(allTasks());
+    // The snapshot now covers everything the journal recorded
+    fileManager.truncateJournal();
+    changesSinceSnapshot = 0;
+    lastSnapshotMs = currentTimeMs();
     fileManager.logAction("Saved tasks to file");
 }
 
+bool MinHeap::exportToCsv(const std::string& path) {
+    return fileManager.exportCsv(path, allTasks());
+}
+
 void MinHeap::createBackup() {
-    fileManager.createBackup(heap);
+    fileManager.createBackup(allTasks());
+    backupDelta.clear();
 }
 
-void MinHeap::generateReport() {
-    fileManager.generateReport(heap, completedTasks);
+void MinHeap::createAutomaticBackup() {
+    // Deltas build on the current base until deltasPerBase is reached
+    if (config.incrementalBackups &&
+        fileManager.deltasSinceBase() < config.deltasPerBase &&
+        fileManager.createIncrementalBackup(backupDelta)) {
+        backupDelta.clear();
+        fileManager.logAction("Created automatic incremental backup after 5 task completions");
+        return;
+    }
+    
+    createBackup();
+    fileManager.logAction("Created automatic backup after 5 task completions");
 }
 
-bool MinHeap::restoreFromLatestBackup() {
+std::string MinHeap::generateReport() {
+    // Only the copy happens here; the file is written in the background
+    return fileManager.generateReport(allTasks(), completed.recent());
+}
+
+bool MinHeap::mergeLatestBackup() {
+    SCHEDULER_STAT_SCOPE(StatOp::Restore);
     std::string latestBackup = fileManager.getLatestBackupFile();
     if (latestBackup.empty()) {
         return false;
@@ -167,18 +552,60 @@ bool MinHeap::restoreFromLatestBackup() {
         return false;
     }
 
-    // Clear current heap and existing task IDs
-    heap.clear();
-    existingTaskIds.clear();
+    // Live tasks win: backup entries whose ID is still scheduled are skipped
+    restoredTasks.erase(std::remove_if(restoredTasks.begin(), restoredTasks.end(),
+                                       [this](const Task& task) { return isTaskIdExists(task.getId()); }),
+                        restoredTasks.end());
+    size_t merged = restoredTasks.size();
 
-    // Add restored tasks
+    // Journaled like any other adds; the queue keeps its current contents
+    std::vector<JournalRecord> records;
+    records.reserve(merged);
     for (const auto& task : restoredTasks) {
-        try {
-            addTask(task);
-        } catch (const std::exception& e) {
-            fileManager.logAction("Error restoring task: " + std::string(e.what()));
-            return false;
-        }
+        records.push_back(addRecord(task));
+    }
+    insertTasks(std::move(restoredTasks), true);
+    for (const auto& record : records) {
+        recordMutation(record);
+    }
+    if (merged > 0) {
+        saveSnapshotIfNeeded(merged);
+    }
+
+    fileManager.logAction("Merged " + std::to_string(merged) + " tasks from backup: " + latestBackup);
+    return true;
+}
+
+bool MinHeap::restoreFromLatestBackup() {
+    SCHEDULER_STAT_SCOPE(StatOp::Restore);
+    std::string latestBackup = fileManager.getLatestBackupFile();
+    if (latestBackup.empty()) {
+        return false;
+    }
+
+    std::vector<Task> restoredTasks;
+    if (!fileManager.restoreFromBackup(latestBackup, restoredTasks)) {
+        return false;
+    }
+
+    // Clear the current queue, its ID index and any pending timers
+    queue->clear();
+    timers.clear();
+
+    // Add restored tasks in one bottom-up build
+    try {
+        insertTasks(std::move(restoredTasks));
+    } catch (const std::exception& e) {
+        fileManager.logAction("Error restoring task: " + std::string(e.what()));
+        return false;
+    }
+
+    backupDelta.clear();
+    fileManager.resetBackupChain();
+
+    // The journal describes the pre-restore queue; rebase it on the restored state
+    if (config.persistence == PersistenceMode::Journal) {
+        saveToFile();
     }
 
     fileManager.logAction("Restored from backup: " + latestBackup);
@@ -0,0 +1,228 @@
+#include "pairing_heap_queue.hpp"
+#include <algorithm>
+
+namespace {
+
+const size_t MAX_BLOCK_NODES = 4096;  // Blocks double up to this many nodes
+
+}  // namespace
+
+PairingHeapQueue::Node* PairingHeapQueue::allocate(Task task) {
+    if (freeHead == nullptr) {
+        blocks.push_back(std::make_unique<Node[]>(nextBlockSize));
+        Node* block = blocks.back().get();
+        for (size_t i = 0; i + 1 < nextBlockSize; ++i) {
+            block[i].next = &block[i + 1];
+        }
+        freeHead = block;
+        freeTail = &block[nextBlockSize - 1];
+        nextBlockSize = std::min(nextBlockSize * 2, MAX_BLOCK_NODES);
+    }
+    
+    Node* node = freeHead;
+    freeHead = node->next;
+    if (freeHead == nullptr) freeTail = nullptr;
+    node->task = std::move(task);
+    node->child = node->next = node->prev = nullptr;
+    return node;
+}
+
+void PairingHeapQueue::release(Node* node) {
+    node->task = Task();  // Drops the description's reference now, not on reuse
+    node->child = node->prev = nullptr;
+    node->next = freeHead;
+    freeHead = node;
+    if (freeTail == nullptr) freeTail = node;
+}
+
+PairingHeapQueue::Node* PairingHeapQueue::link(Node* first, Node* second) {
+    // Both are detached roots; the loser becomes the winner's leftmost child
+    if (second->task.getPriority() < first->task.getPriority()) {
+        std::swap(first, second);
+    }
+    second->prev = first;
+    second->next = first->child;
+    if (first->child != nullptr) first->child->prev = second;
+    first->child = second;
+    return first;
+}
+
+PairingHeapQueue::Node* PairingHeapQueue::mergeSiblings(Node* first) {
+    if (first == nullptr) return nullptr;
+    
+    // Pass one links neighbours left to right
+    pairs.clear();
+    while (first != nullptr) {
+        Node* a = first;
+        Node* b = a->next;
+        a->next = a->prev = nullptr;
+        if (b == nullptr) {
+            pairs.push_back(a);
+            break;
+        }
+        first = b->next;
+        b->next = b->prev = nullptr;
+        pairs.push_back(link(a, b));
+    }
+    
+    // Pass two folds the pairs right to left into one tree
+    Node* merged = pairs.back();
+    for (size_t i = pairs.size() - 1; i-- > 0;) {
+        merged = link(pairs[i], merged);
+    }
+    return merged;
+}
+
+void PairingHeapQueue::cut(Node* node) {
+    if (node->prev->child == node) {
+        node->prev->child = node->next;
+    } else {
+        node->prev->next = node->next;
+    }
+    if (node->next != nullptr) node->next->prev = node->prev;
+    node->next = node->prev = nullptr;
+}
+
+void PairingHeapQueue::detach(Node* node) {
+    // Takes node out alone; its children rejoin the heap as one tree
+    Node* children = node->child;
+    node->child = nullptr;
+    if (node == root) {
+        root = mergeSiblings(children);
+        return;
+    }
+    cut(node);
+    Node* rest = mergeSiblings(children);
+    if (rest != nullptr) root = link(root, rest);
+}
+
+PairingHeapQueue::Node* PairingHeapQueue::find(int taskId) const {
+    auto it = index->map.find(taskId);
+    return it == index->map.end() ? nullptr : it->second;
+}
+
+void PairingHeapQueue::push(Task task) {
+    pushHandle(std::move(task));
+}
+
+PairingHeapQueue::Handle PairingHeapQueue::pushHandle(Task task) {
+    Node* node = allocate(std::move(task));
+    index->map[node->task.getId()] = node;
+    root = root == nullptr ? node : link(root, node);
+    return node;
+}
+
+Task PairingHeapQueue::pop() {
+    Node* top = root;
+    root = mergeSiblings(top->child);
+    top->child = nullptr;
+    
+    Task task = std::move(top->task);
+    index->map.erase(task.getId());
+    release(top);
+    return task;
+}
+
+void PairingHeapQueue::decreaseKey(Handle handle, int newPriority) {
+    // The subtree stays heap-ordered, so it moves up whole
+    handle->task.setPriority(newPriority);
+    if (handle == root) return;
+    cut(handle);
+    root = link(root, handle);
+}
+
+bool PairingHeapQueue::updatePriority(int taskId, int newPriority) {
+    Node* node = find(taskId);
+    if (node == nullptr) {
+        return false;
+    }
+    
+    int oldPriority = node->task.getPriority();
+    if (newPriority < oldPriority) {
+        decreaseKey(node, newPriority);
+    } else if (newPriority > oldPriority) {
+        // A larger key may break order below the node; reinsert it alone
+        detach(node);
+        node->task.setPriority(newPriority);
+        root = root == nullptr ? node : link(root, node);
+    }
+    return true;
+}
+
+bool PairingHeapQueue::remove(int taskId, Task& removed) {
+    Node* node = find(taskId);
+    if (node == nullptr) {
+        return false;
+    }
+    
+    detach(node);
+    removed = std::move(node->task);
+    index->map.erase(taskId);
+    release(node);
+    return true;
+}
+
+void PairingHeapQueue::clear() {
+    root = nullptr;
+    blocks.clear();
+    nextBlockSize = 64;
+    freeHead = freeTail = nullptr;
+    index->map.clear();
+}
+
+std::vector<Task> PairingHeapQueue::tasks() const {
+    std::vector<Task> result;
+    result.reserve(size());
+    std::vector<const Node*> pending;
+    if (root != nullptr) pending.push_back(root);
+    while (!pending.empty()) {
+        const Node* node = pending.back();
+        pending.pop_back();
+        result.push_back(node->task);
+        if (node->child != nullptr) pending.push_back(node->child);
+        if (node->next != nullptr) pending.push_back(node->next);
+    }
+    return result;
+}
+
+void PairingHeapQueue::meld(PairingHeapQueue& other) {
+    if (&other == this) return;
+    
+    // Adopt the other queue's node blocks and free list wholesale
+    for (auto& block : other.blocks) {
+        blocks.push_back(std::move(block));
+    }
+    other.blocks.clear();
+    if (other.freeHead != nullptr) {
+        if (freeTail != nullptr) {
+            freeTail->next = other.freeHead;
+        } else {
+            freeHead = other.freeHead;
+        }
+        freeTail = other.freeTail;
+    }
+    other.freeHead = other.freeTail = nullptr;
+    nextBlockSize = std::max(nextBlockSize, other.nextBlockSize);
+    other.nextBlockSize = 64;
+    
+    // Fold the smaller ID index into the larger one
+    if (index->map.size() < other.index->map.size()) {
+        std::swap(index, other.index);
+    }
+    index->map.reserve(index->map.size() + other.index->map.size());
+    index->map.insert(other.index->map.begin(), other.index->map.end());
+    other.index->map.clear();
+    
+    if (other.root != nullptr) {
+        root = root == nullptr ? other.root : link(root, other.root);
+        other.root = nullptr;
+    }
+}
+
+void PairingHeapQueue::merge(TaskQueue& other) {
+    if (auto* pairing = dynamic_cast<PairingHeapQueue*>(&other)) {
+        meld(*pairing);
+    } else {
+        TaskQueue::merge(other);
+    }
+}
@@ -1,8 +1,16 @@
+#include <chrono>
 #include <iostream>
 #include <limits>
 #include <filesystem>
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include "batch_runner.hpp"
 #include "min_heap.hpp"
 #include "file_manager.hpp"
+#include "scheduler_daemon.hpp"
 
 namespace fs = std::filesystem;
 
@@ -20,7 +28,10 @@ void displayMenu() {
               << "5. Create Backup\n"
               << "6. Generate HTML Report\n"
               << "7. Restore from Latest Backup\n"
-              << "8. Exit\n"
+              << "8. Cancel Task\n"
+              << "9. Export Tasks to CSV\n"
+              << "10. Show Operation Statistics\n"
+              << "11. Exit\n"
               << "Enter your choice: ";
 }
 
@@ -28,12 +39,85 @@ bool isValidPriority(int priority) {
     return priority >= 1 && priority <= 100;  // Assuming valid priority range is 1-100
 }
 
-int main() {
+// Runs the commands in path ("-" for stdin) and answers on stdout
+int runBatchMode(MinHeap& taskScheduler, const char* path) {
+    int inFd = STDIN_FILENO;
+    if (std::strcmp(path, "-") != 0) {
+        inFd = ::open(path, O_RDONLY);
+        if (inFd < 0) {
+            std::cerr << "Error: cannot open " << path << ": " << std::strerror(errno) << "\n";
+            return 2;
+        }
+    }
+    
+    BatchRunner runner(taskScheduler);
+    size_t failures = runner.run(inFd, STDOUT_FILENO);
+    if (inFd != STDIN_FILENO) ::close(inFd);
+    
+    taskScheduler.saveToFile();
+    taskScheduler.flushLogs();
+    return failures == 0 ? 0 : 1;
+}
+
+SchedulerDaemon* runningDaemon = nullptr;
+
+void stopDaemon(int) {
+    if (runningDaemon != nullptr) runningDaemon->stop();
+}
+
+// Serves the queue on a Unix domain socket until SIGINT or SIGTERM
+int runDaemonMode(MinHeap& taskScheduler, const char* socketPath) {
+    DaemonConfig config;
+    if (socketPath != nullptr) config.socketPath = socketPath;
+    
+    try {
+        SchedulerDaemon daemon(taskScheduler, config);
+        daemon.listen();
+        runningDaemon = &daemon;
+        std::signal(SIGINT, stopDaemon);
+        std::signal(SIGTERM, stopDaemon);
+        std::cout << "Serving tasks on " << config.socketPath << std::endl;
+        daemon.run();
+        runningDaemon = nullptr;
+    } catch (const std::exception& e) {
+        runningDaemon = nullptr;
+        std::cerr << "Error: " << e.what() << "\n";
+        return 2;
+    }
+    
+    taskScheduler.saveToFile();
+    taskScheduler.flushLogs();
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
     MinHeap taskScheduler;
     int choice, taskId, priority;
     std::string description;
     
+    // Recover the last snapshot plus any journaled changes made after it
+    try {
+        taskScheduler.loadFromFile();
+    } catch (const std::exception& e) {
+        std::cout << "Warning: could not load saved tasks: " << e.what() << "\n";
+    }
+    
+    // --batch [file]: scripted mode, one command per line, no menu
+    if (argc > 1 && std::strcmp(argv[1], "--batch") == 0) {
+        return runBatchMode(taskScheduler, argc > 2 ? argv[2] : "-");
+    }
+    // --daemon [socket]: share this queue with clients over a local socket
+    if (argc > 1 && std::strcmp(argv[1], "--daemon") == 0) {
+        return runDaemonMode(taskScheduler, argc > 2 ? argv[2] : nullptr);
+    }
+    
+    taskScheduler.setDeadlineCallback([](const Task& task) {
+        std::cout << "Deadline passed for task " << task.getId()
+                  << " (" << task.getDescription() << ")\n";
+    });
+    
     while (true) {
+        taskScheduler.advanceTimers();
         displayMenu();
         
         if (!(std::cin >> choice)) {
@@ -68,7 +152,21 @@ int main() {
                         throw std::runtime_error("Task description cannot be empty.");
                     }
                     
+                    int delaySeconds = 0, deadlineSeconds = 0;
+                    std::cout << "Delay before the task is eligible, in seconds (0 = none): ";
+                    if (!(std::cin >> delaySeconds) || delaySeconds < 0) {
+                        throw std::runtime_error("Invalid delay. Please enter a non-negative number.");
+                    }
+                    std::cout << "Deadline in seconds from now (0 = none): ";
+                    if (!(std::cin >> deadlineSeconds) || deadlineSeconds < 0) {
+                        throw std::runtime_error("Invalid deadline. Please enter a non-negative number.");
+                    }
+                    
                     Task newTask(taskId, description, priority);
+                    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+                    if (delaySeconds > 0) newTask.setNotBefore(now + delaySeconds * 1000LL);
+                    if (deadlineSeconds > 0) newTask.setDeadline(now + deadlineSeconds * 1000LL);
                     taskScheduler.addTask(newTask);
                     std::cout << "Task added successfully!\n";
                     break;
@@ -119,8 +217,8 @@ int main() {
                 }
 
                 case 6: {
-                    taskScheduler.generateReport();
-                    std::cout << "HTML report generated successfully!\n";
+                    std::string reportPath = taskScheduler.generateReport();
+                    std::cout << "HTML report is being written to " << reportPath << "\n";
                     break;
                 }
 
@@ -134,11 +232,22 @@ int main() {
                     std::cout << "\nAvailable restore points:\n";
                     for (size_t i = 0; i < backups.size(); ++i) {
                         // Extract just the filename from the path
-                        std::string filename = fs::path(backups[i]).filename().string();
-                        std::cout << i + 1 << ". " << filename << "\n";
+                        std::string filename = fs::path(backups[i].path).filename().string();
+                        std::cout << i + 1 << ". " << filename << " ("
+                                  << backups[i].taskCount << (backups[i].isDelta() ? " changes, " : " tasks, ")
+                                  << backups[i].bytes << " bytes)\n";
                     }
 
-                    if (taskScheduler.restoreFromLatestBackup()) {
+                    std::cout << "Replace current tasks (r) or merge the backup into them (m)? ";
+                    char mode = 'r';
+                    std::cin >> mode;
+                    if (mode == 'm' || mode == 'M') {
+                        if (taskScheduler.mergeLatestBackup()) {
+                            std::cout << "Merged latest backup into the current tasks!\n";
+                        } else {
+                            std::cout << "Merge failed. Please check the log file for details.\n";
+                        }
+                    } else if (taskScheduler.restoreFromLatestBackup()) {
                         std::cout << "Successfully restored from latest backup!\n";
                     } else {
                         std::cout << "Restore failed. Please check the log file for details.\n";
@@ -146,13 +255,44 @@ int main() {
                     break;
                 }
 
-                case 8:
+                case 8: {
+                    std::cout << "Enter Task ID to cancel: ";
+                    if (!(std::cin >> taskId)) {
+                        throw std::runtime_error("Invalid Task ID format.");
+                    }
+                    
+                    if (!taskScheduler.isTaskIdExists(taskId)) {
+                        throw std::runtime_error("Task ID does not exist.");
+                    }
+                    
+                    Task cancelledTask = taskScheduler.cancelTask(taskId);
+                    std::cout << "Cancelled task " << cancelledTask.getId()
+                              << " (" << cancelledTask.getDescription() << ")\n";
+                    break;
+                }
+
+                case 9: {
+                    std::string exportPath = "data/tasks_export.csv";
+                    if (taskScheduler.exportToCsv(exportPath)) {
+                        std::cout << "Tasks exported to " << exportPath << "\n";
+                    } else {
+                        std::cout << "Export failed. Please check the log file for details.\n";
+                    }
+                    break;
+                }
+
+                case 10:
+                    SchedulerStats::print(std::cout, taskScheduler.stats());
+                    break;
+
+                case 11:
                     taskScheduler.saveToFile();
+                    taskScheduler.flushLogs();
                     std::cout << "Saving tasks and exiting...\n";
                     return 0;
                 
                 default:
-                    std::cout << "Invalid choice! Please enter a number between 1 and 5.\n";
+                    std::cout << "Invalid choice! Please enter a number between 1 and 11.\n";
             }
         } catch (const std::exception& e) {
             std::cout << "Error: " << e.what() << "\n";
@@ -0,0 +1,237 @@
+#include "scheduler_client.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t READ_CHUNK_BYTES = 64 * 1024;
+
+std::runtime_error connectionError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+void appendInt(std::string& out, long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+int parseInt(std::string_view& rest) {
+    size_t start = rest.find_first_not_of(' ');
+    if (start == std::string_view::npos) start = rest.size();
+    rest.remove_prefix(start);
+    int value = 0;
+    auto result = std::from_chars(rest.data(), rest.data() + rest.size(), value);
+    rest.remove_prefix(result.ptr - rest.data());
+    return value;
+}
+
+// "<id> <priority> <description>", as sent after TASK and DEADLINE
+Task parseTask(std::string_view rest) {
+    int id = parseInt(rest);
+    int priority = parseInt(rest);
+    if (!rest.empty()) rest.remove_prefix(1);
+    return Task(id, rest, priority);
+}
+
+// "ERR <line> <message>" -> "<message>"
+std::string errorMessage(std::string_view line) {
+    line.remove_prefix(4);
+    size_t space = line.find(' ');
+    return std::string(space == std::string_view::npos ? line : line.substr(space + 1));
+}
+
+}  // namespace
+
+SchedulerClient::SchedulerClient(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is too long: " + socketPath);
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw connectionError("Failed to create a client socket");
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        std::runtime_error error = connectionError("Cannot reach the daemon at " + socketPath);
+        ::close(fd);
+        throw error;
+    }
+}
+
+SchedulerClient::~SchedulerClient() {
+    if (fd >= 0) ::close(fd);
+}
+
+void SchedulerClient::queueAdd(const Task& task) {
+    std::string_view description = task.getDescription();
+    if (description.find('\n') != std::string_view::npos) {
+        throw std::invalid_argument("Task description cannot contain a newline");
+    }
+    out += "ADD ";
+    appendInt(out, task.getId());
+    out += ' ';
+    appendInt(out, task.getPriority());
+    out += ' ';
+    out += description;
+    out += '\n';
+    expected.push_back({ReplyKind::Status, 0});
+}
+
+void SchedulerClient::queuePop(size_t count) {
+    out += "POP ";
+    appendInt(out, static_cast<long long>(count));
+    out += '\n';
+    expected.push_back({ReplyKind::Pop, count});
+}
+
+void SchedulerClient::queuePopWait(int timeoutMs, size_t count) {
+    out += "POPWAIT ";
+    appendInt(out, timeoutMs);
+    out += ' ';
+    appendInt(out, static_cast<long long>(count));
+    out += '\n';
+    expected.push_back({ReplyKind::Pop, count});
+}
+
+void SchedulerClient::queueUpdate(int taskId, int newPriority) {
+    out += "UPDATE ";
+    appendInt(out, taskId);
+    out += ' ';
+    appendInt(out, newPriority);
+    out += '\n';
+    expected.push_back({ReplyKind::Status, 0});
+}
+
+void SchedulerClient::queueCancel(int taskId) {
+    out += "CANCEL ";
+    appendInt(out, taskId);
+    out += '\n';
+    expected.push_back({ReplyKind::Status, 0});
+}
+
+void SchedulerClient::queueStats() {
+    out += "STATS\n";
+    expected.push_back({ReplyKind::Stats, 0});
+}
+
+void SchedulerClient::send() {
+    size_t sent = 0;
+    while (sent < out.size()) {
+        ssize_t written = ::send(fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw connectionError("Lost the daemon connection");
+        }
+        sent += static_cast<size_t>(written);
+    }
+    out.clear();
+}
+
+bool SchedulerClient::readLine(std::string& line) {
+    while (true) {
+        size_t newline = in.find('\n', inPos);
+        if (newline != std::string::npos) {
+            line.assign(in, inPos, newline - inPos);
+            inPos = newline + 1;
+            return true;
+        }
+        in.erase(0, inPos);
+        inPos = 0;
+
+        size_t used = in.size();
+        in.resize(used + READ_CHUNK_BYTES);
+        ssize_t got = ::read(fd, &in[used], READ_CHUNK_BYTES);
+        in.resize(used + (got > 0 ? static_cast<size_t>(got) : 0));
+        if (got == 0) return false;
+        if (got < 0 && errno != EINTR) return false;
+    }
+}
+
+DaemonReply SchedulerClient::readReply() {
+    if (expected.empty()) {
+        throw std::logic_error("No command is waiting for an answer");
+    }
+    if (!out.empty()) send();
+    Expected next = expected.front();
+    expected.pop_front();
+
+    DaemonReply reply;
+    std::string line;
+    while (true) {
+        if (!readLine(line)) {
+            throw std::runtime_error("The daemon closed the connection");
+        }
+        if (line.rfind("DEADLINE ", 0) == 0) {
+            reply.deadlines.push_back(parseTask(std::string_view(line).substr(9)));
+            continue;
+        }
+        if (line.rfind("ERR ", 0) == 0) {
+            reply.ok = false;
+            reply.error = errorMessage(line);
+            return reply;
+        }
+        switch (next.kind) {
+            case ReplyKind::Status:
+                return reply;
+            case ReplyKind::Stats:
+                reply.text = line;
+                return reply;
+            case ReplyKind::Pop:
+                if (line == "EMPTY") {
+                    reply.empty = true;
+                    return reply;
+                }
+                if (line.rfind("TASK ", 0) == 0) {
+                    reply.tasks.push_back(parseTask(std::string_view(line).substr(5)));
+                    if (reply.tasks.size() == next.count) return reply;
+                }
+                break;
+        }
+    }
+}
+
+DaemonReply SchedulerClient::add(const Task& task) {
+    queueAdd(task);
+    return readReply();
+}
+
+std::vector<Task> SchedulerClient::pop(size_t count) {
+    queuePop(count);
+    DaemonReply reply = readReply();
+    if (!reply.ok) throw std::runtime_error(reply.error);
+    return std::move(reply.tasks);
+}
+
+std::vector<Task> SchedulerClient::popWait(int timeoutMs, size_t count) {
+    queuePopWait(timeoutMs, count);
+    DaemonReply reply = readReply();
+    if (!reply.ok) throw std::runtime_error(reply.error);
+    return std::move(reply.tasks);
+}
+
+DaemonReply SchedulerClient::update(int taskId, int newPriority) {
+    queueUpdate(taskId, newPriority);
+    return readReply();
+}
+
+DaemonReply SchedulerClient::cancel(int taskId) {
+    queueCancel(taskId);
+    return readReply();
+}
+
+std::string SchedulerClient::stats() {
+    queueStats();
+    DaemonReply reply = readReply();
+    if (!reply.ok) throw std::runtime_error(reply.error);
+    return reply.text;
+}
@@ -0,0 +1,372 @@
+#include "scheduler_daemon.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t READ_CHUNK_BYTES = 64 * 1024;
+const size_t MAX_BUFFERED_INPUT = 1 << 20;  // Unrun commands held per connection
+const int MAX_EVENTS = 256;
+
+std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+sockaddr_un socketAddress(const std::string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is too long: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+}  // namespace
+
+SchedulerDaemon::SchedulerDaemon(MinHeap& scheduler, const DaemonConfig& daemonConfig)
+    : heap(scheduler), config(daemonConfig) {
+    if (config.maxCommandsPerRound == 0) config.maxCommandsPerRound = 1;
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        throw systemError("Failed to create the daemon event loop");
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+}
+
+SchedulerDaemon::~SchedulerDaemon() {
+    heap.setDeadlineCallback(nullptr);
+    while (!connections.empty()) {
+        close(connections.begin()->first);
+    }
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        ::unlink(config.socketPath.c_str());
+    }
+    if (wakeFd >= 0) ::close(wakeFd);
+    if (epollFd >= 0) ::close(epollFd);
+}
+
+void SchedulerDaemon::listen() {
+    sockaddr_un address = socketAddress(config.socketPath);
+
+    // A socket file left by a daemon that died is replaced; a live one is
+    // not, and neither is anything else found at the path
+    struct stat existing;
+    if (::lstat(config.socketPath.c_str(), &existing) == 0 && !S_ISSOCK(existing.st_mode)) {
+        throw std::runtime_error("Not a socket, refusing to replace it: " + config.socketPath);
+    }
+    int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe >= 0) {
+        bool live = ::connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        ::close(probe);
+        if (live) {
+            throw std::runtime_error("Another daemon is serving " + config.socketPath);
+        }
+    }
+    ::unlink(config.socketPath.c_str());
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        throw systemError("Failed to create the daemon socket");
+    }
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, SOMAXCONN) != 0) {
+        std::runtime_error error = systemError("Failed to listen on " + config.socketPath);
+        ::close(listenFd);
+        listenFd = -1;
+        throw error;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+}
+
+void SchedulerDaemon::stop() {
+    uint64_t one = 1;
+    ssize_t written = ::write(wakeFd, &one, sizeof(one));
+    (void)written;  // A pending wakeup already ends the loop
+}
+
+void SchedulerDaemon::run() {
+    epoll_event events[MAX_EVENTS];
+    heap.setDeadlineCallback([this](const Task& task) { expired.push_back(task); });
+    running = true;
+    while (running) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, ready.empty() ? pollTimeoutMs() : 0);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            throw systemError("Daemon event loop failed");
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) {
+                uint64_t value;
+                ssize_t got = ::read(wakeFd, &value, sizeof(value));
+                (void)got;
+                running = false;
+                continue;
+            }
+            if (fd == listenFd) {
+                acceptClients();
+                continue;
+            }
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            Connection& connection = *it->second;
+
+            // A client that hung up while parked takes nothing; commands it
+            // sent before hanging up still run
+            if ((events[i].events & EPOLLERR) ||
+                ((events[i].events & EPOLLHUP) && connection.runner.waiting())) {
+                close(fd);
+                continue;
+            }
+            if ((events[i].events & EPOLLOUT) && !flushOutput(connection)) {
+                close(fd);
+                continue;
+            }
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) {
+                readFrom(connection);
+            }
+        }
+
+        // Every connection's commands this round share one heap batch, so
+        // the round is journaled and flushed once
+        if (!ready.empty() || !waiters.empty()) {
+            heap.beginBatch();
+            heap.advanceTimers();
+            std::vector<int> serving;
+            serving.swap(ready);
+            for (int fd : serving) {
+                auto it = connections.find(fd);
+                if (it == connections.end()) continue;
+                it->second->queued = false;
+                serve(*it->second);
+            }
+            resumeWaiters();
+            reportDeadlines(serving);
+            heap.endBatch();
+        }
+
+        for (int fd : pendingWrites) {
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            Connection& connection = *it->second;
+            connection.touched = false;
+            if (!flushOutput(connection)) {
+                close(fd);
+            } else if (connection.readClosed && connection.input.empty() &&
+                       connection.runner.output().empty() && !connection.runner.waiting()) {
+                close(fd);
+            }
+        }
+        pendingWrites.clear();
+    }
+}
+
+void SchedulerDaemon::acceptClients() {
+    while (true) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;  // EAGAIN once the backlog is empty
+        }
+        if (connections.size() >= config.maxConnections) {
+            ::close(fd);
+            continue;
+        }
+
+        BatchConfig batchConfig;
+        batchConfig.allowWait = true;
+        auto connection = std::make_unique<Connection>(fd, heap, batchConfig);
+        connection->events = EPOLLIN | EPOLLRDHUP;
+        epoll_event event{};
+        event.events = connection->events;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        connections.emplace(fd, std::move(connection));
+    }
+}
+
+void SchedulerDaemon::readFrom(Connection& connection) {
+    while (connection.input.size() < MAX_BUFFERED_INPUT) {
+        size_t used = connection.input.size();
+        connection.input.resize(used + READ_CHUNK_BYTES);
+        ssize_t got = ::read(connection.fd, &connection.input[used], READ_CHUNK_BYTES);
+        connection.input.resize(used + (got > 0 ? static_cast<size_t>(got) : 0));
+        if (got > 0) continue;
+        if (got < 0 && errno == EINTR) continue;
+        if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            connection.readClosed = true;
+        }
+        break;
+    }
+    schedule(connection);
+    watch(connection);
+}
+
+void SchedulerDaemon::schedule(Connection& connection) {
+    if (!connection.queued) {
+        connection.queued = true;
+        ready.push_back(connection.fd);
+    }
+}
+
+void SchedulerDaemon::serve(Connection& connection) {
+    if (connection.runner.waiting()) return;  // resumeWaiters answers it first
+    if (connection.runner.output().size() >= config.maxPendingOutputBytes) return;  // Resumed once drained
+
+    // Complete lines only, as in batch mode; a closed peer's last line counts
+    const std::string& input = connection.input;
+    lines.clear();
+    lineEnds.clear();
+    size_t consumed = 0;
+    while (consumed < input.size() && lines.size() < config.maxCommandsPerRound) {
+        const char* start = input.data() + consumed;
+        const char* newline = static_cast<const char*>(std::memchr(start, '\n', input.size() - consumed));
+        if (newline == nullptr) {
+            if (!connection.readClosed) break;
+            lines.emplace_back(start, input.size() - consumed);
+            consumed = input.size();
+        } else {
+            lines.emplace_back(start, newline - start);
+            consumed = newline - input.data() + 1;
+        }
+        lineEnds.push_back(consumed);
+    }
+    if (lines.empty()) {
+        if (connection.readClosed) answered(connection);  // So it gets closed once idle
+        return;
+    }
+
+    size_t used = connection.runner.runCommands(lines);
+    bool more = used == config.maxCommandsPerRound;
+    connection.input.erase(0, lineEnds[used - 1]);
+    answered(connection);
+    if (connection.runner.waiting()) {
+        waiters.push_back(connection.fd);
+    } else if (more) {
+        schedule(connection);  // The rest runs next round, after the others
+    }
+    watch(connection);
+}
+
+void SchedulerDaemon::resumeWaiters() {
+    auto now = std::chrono::steady_clock::now();
+    size_t kept = 0;
+    for (int fd : waiters) {
+        auto it = connections.find(fd);
+        if (it == connections.end() || !it->second->runner.waiting()) continue;
+        Connection& connection = *it->second;
+        if (!connection.runner.resumeWait(now >= connection.runner.waitDeadline())) {
+            waiters[kept++] = fd;
+            continue;
+        }
+        answered(connection);
+        schedule(connection);  // Commands pipelined behind the wait
+    }
+    waiters.resize(kept);
+}
+
+void SchedulerDaemon::reportDeadlines(const std::vector<int>& served) {
+    if (expired.empty()) return;
+
+    // A parked consumer is already reading; otherwise the first client
+    // answered this round reads them ahead of its next answer
+    auto firstOpen = [this](const std::vector<int>& fds) -> Connection* {
+        for (int fd : fds) {
+            auto it = connections.find(fd);
+            if (it != connections.end()) return it->second.get();
+        }
+        return nullptr;
+    };
+    Connection* target = firstOpen(waiters);
+    if (target == nullptr) target = firstOpen(served);
+    if (target == nullptr) return;  // Kept for the next round
+
+    for (const auto& task : expired) {
+        target->runner.reportDeadline(task);
+    }
+    expired.clear();
+    answered(*target);
+}
+
+void SchedulerDaemon::answered(Connection& connection) {
+    if (!connection.touched && (!connection.runner.output().empty() || connection.readClosed)) {
+        connection.touched = true;
+        pendingWrites.push_back(connection.fd);
+    }
+}
+
+bool SchedulerDaemon::flushOutput(Connection& connection) {
+    std::string& out = connection.runner.output();
+    size_t sent = 0;
+    while (sent < out.size()) {
+        ssize_t written = ::send(connection.fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    out.erase(0, sent);
+    if (out.empty() && !connection.input.empty()) {
+        schedule(connection);  // Commands held back while answers piled up
+    }
+    watch(connection);
+    return true;
+}
+
+void SchedulerDaemon::watch(Connection& connection) {
+    // Stop reading from a client that is not taking its answers, or that
+    // already has a full buffer of commands to run
+    bool wantRead = !connection.readClosed && connection.input.size() < MAX_BUFFERED_INPUT &&
+                    connection.runner.output().size() < config.maxPendingOutputBytes;
+    uint32_t events = (wantRead ? static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP) : 0u) |
+                      (connection.runner.output().empty() ? 0u : static_cast<uint32_t>(EPOLLOUT));
+    if (events == connection.events) return;
+    connection.events = events;
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = connection.fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+}
+
+void SchedulerDaemon::close(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections.erase(fd);
+}
+
+int SchedulerDaemon::pollTimeoutMs() const {
+    if (waiters.empty()) return -1;
+
+    // Wake for the nearest POPWAIT timeout, and at least every tick so
+    // delayed tasks coming due can answer a waiter
+    auto now = std::chrono::steady_clock::now();
+    auto nearest = std::chrono::milliseconds(config.waitTickMs);
+    for (int fd : waiters) {
+        auto it = connections.find(fd);
+        if (it == connections.end()) continue;
+        auto left = std::chrono::ceil<std::chrono::milliseconds>(it->second->runner.waitDeadline() - now);
+        nearest = std::min(nearest, std::max(left, std::chrono::milliseconds(0)));
+    }
+    return static_cast<int>(nearest.count());
+}
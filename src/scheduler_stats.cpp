@@ -0,0 +1,268 @@
+#include "scheduler_stats.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const OP_NAMES[STAT_OP_COUNT] = {
+    "add", "pop", "update", "cancel", "save", "load", "log", "backup", "restore"
+};
+
+#if SCHEDULER_ENABLE_STATS
+
+// Values below 16 ns get exact buckets; above that each power of two is split
+// into 16 linear sub-buckets. Samples of 2^40 ns (~18 minutes) or more share
+// the last bucket.
+const int SUB_BUCKET_BITS = 4;
+const uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+const int MAX_MAGNITUDE = 39;
+const size_t BUCKET_COUNT = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+size_t bucketFor(uint64_t ns) {
+    if (ns < SUB_BUCKETS) return static_cast<size_t>(ns);
+    int magnitude = 63 - __builtin_clzll(ns);
+    if (magnitude > MAX_MAGNITUDE) return BUCKET_COUNT - 1;
+    uint64_t sub = (ns >> (magnitude - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return (magnitude - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+// Largest value that lands in the bucket
+uint64_t bucketUpperBound(size_t bucket) {
+    if (bucket < SUB_BUCKETS) return bucket;
+    int magnitude = static_cast<int>(bucket / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+    uint64_t sub = bucket % SUB_BUCKETS;
+    uint64_t width = 1ULL << (magnitude - SUB_BUCKET_BITS);
+    return ((SUB_BUCKETS + sub) << (magnitude - SUB_BUCKET_BITS)) + width - 1;
+}
+
+// Only the owning thread writes a block, so load + store is enough; the
+// atomics just make the concurrent reads in snapshot() well defined.
+struct OpHistogram {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> failed{0};
+    std::atomic<uint64_t> totalNs{0};
+    std::atomic<uint64_t> maxNs{0};
+    std::atomic<uint64_t> buckets[BUCKET_COUNT] = {};
+};
+
+void bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+void addInto(OpHistogram& into, const OpHistogram& from) {
+    bump(into.count, from.count.load(std::memory_order_relaxed));
+    bump(into.failed, from.failed.load(std::memory_order_relaxed));
+    bump(into.totalNs, from.totalNs.load(std::memory_order_relaxed));
+    into.maxNs.store(std::max(into.maxNs.load(std::memory_order_relaxed),
+                              from.maxNs.load(std::memory_order_relaxed)),
+                     std::memory_order_relaxed);
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        bump(into.buckets[i], from.buckets[i].load(std::memory_order_relaxed));
+    }
+}
+
+void clear(OpHistogram& histogram) {
+    histogram.count.store(0, std::memory_order_relaxed);
+    histogram.failed.store(0, std::memory_order_relaxed);
+    histogram.totalNs.store(0, std::memory_order_relaxed);
+    histogram.maxNs.store(0, std::memory_order_relaxed);
+    for (auto& bucket : histogram.buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+struct ThreadBlock {
+    OpHistogram ops[STAT_OP_COUNT];
+};
+
+// When a thread exits, its counts fold into retired and its block, now
+// zeroed, goes on the free list for the next new thread, so short-lived
+// threads do not grow memory. The registry is never destroyed, which keeps
+// late recorders safe during process exit.
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBlock>> blocks;  // Live and free
+    std::vector<ThreadBlock*> freeBlocks;
+    ThreadBlock retired;
+};
+
+Registry& registry() {
+    static Registry* instance = new Registry;
+    return *instance;
+}
+
+ThreadBlock* acquireBlock() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    if (!reg.freeBlocks.empty()) {
+        ThreadBlock* block = reg.freeBlocks.back();
+        reg.freeBlocks.pop_back();
+        return block;
+    }
+    reg.blocks.push_back(std::make_unique<ThreadBlock>());
+    return reg.blocks.back().get();
+}
+
+void releaseBlock(ThreadBlock* block) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (size_t op = 0; op < STAT_OP_COUNT; ++op) {
+        addInto(reg.retired.ops[op], block->ops[op]);
+        clear(block->ops[op]);
+    }
+    reg.freeBlocks.push_back(block);
+}
+
+// Returns the thread's block when the thread exits
+struct BlockLease {
+    ThreadBlock* block = nullptr;
+
+    ~BlockLease() {
+        if (block != nullptr) releaseBlock(block);
+        block = nullptr;
+    }
+};
+
+ThreadBlock& localBlock() {
+    thread_local BlockLease lease;
+    if (lease.block == nullptr) {
+        lease.block = acquireBlock();
+    }
+    return *lease.block;
+}
+
+uint64_t percentile(const std::vector<uint64_t>& buckets, uint64_t count, double fraction) {
+    if (count == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(fraction * (count - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return bucketUpperBound(i);
+    }
+    return bucketUpperBound(buckets.size() - 1);
+}
+
+#endif
+
+std::string formatMicros(double ns) {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(ns < 10000 ? 2 : 0) << ns / 1000.0;
+    return ss.str();
+}
+
+}  // namespace
+
+namespace SchedulerStats {
+
+const char* opName(StatOp op) {
+    return OP_NAMES[static_cast<size_t>(op)];
+}
+
+#if SCHEDULER_ENABLE_STATS
+
+void record(StatOp op, uint64_t nanoseconds, bool failed) {
+    OpHistogram& histogram = localBlock().ops[static_cast<size_t>(op)];
+    bump(histogram.count, 1);
+    bump(histogram.totalNs, nanoseconds);
+    bump(histogram.buckets[bucketFor(nanoseconds)], 1);
+    if (failed) {
+        bump(histogram.failed, 1);
+    }
+    if (nanoseconds > histogram.maxNs.load(std::memory_order_relaxed)) {
+        histogram.maxNs.store(nanoseconds, std::memory_order_relaxed);
+    }
+}
+
+StatsSnapshot snapshot() {
+    StatsSnapshot stats;
+    std::vector<std::vector<uint64_t>> merged(STAT_OP_COUNT, std::vector<uint64_t>(BUCKET_COUNT));
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<const ThreadBlock*> sources{&reg.retired};
+    for (const auto& block : reg.blocks) {
+        sources.push_back(block.get());  // Free blocks are zero
+    }
+    for (const ThreadBlock* block : sources) {
+        for (size_t op = 0; op < STAT_OP_COUNT; ++op) {
+            const OpHistogram& histogram = block->ops[op];
+            OpStats& total = stats.ops[op];
+            total.count += histogram.count.load(std::memory_order_relaxed);
+            total.failed += histogram.failed.load(std::memory_order_relaxed);
+            total.totalNs += histogram.totalNs.load(std::memory_order_relaxed);
+            total.maxNs = std::max(total.maxNs, histogram.maxNs.load(std::memory_order_relaxed));
+            for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+                merged[op][i] += histogram.buckets[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    for (size_t op = 0; op < STAT_OP_COUNT; ++op) {
+        // Percentiles use the bucket total, which a racing writer may have
+        // moved past the count read above
+        uint64_t sampled = 0;
+        for (uint64_t n : merged[op]) sampled += n;
+        OpStats& total = stats.ops[op];
+        total.p50Ns = percentile(merged[op], sampled, 0.50);
+        total.p90Ns = percentile(merged[op], sampled, 0.90);
+        total.p99Ns = percentile(merged[op], sampled, 0.99);
+    }
+    return stats;
+}
+
+void reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& histogram : reg.retired.ops) {
+        clear(histogram);
+    }
+    for (const auto& block : reg.blocks) {
+        for (auto& histogram : block->ops) {
+            clear(histogram);
+        }
+    }
+}
+
+#else
+
+StatsSnapshot snapshot() {
+    return StatsSnapshot();
+}
+
+void reset() {}
+
+#endif
+
+void print(std::ostream& out, const StatsSnapshot& stats) {
+    if (!stats.enabled) {
+        out << "Statistics were disabled at compile time (SCHEDULER_ENABLE_STATS=0).\n";
+        return;
+    }
+
+    out << "\nOperation Statistics (microseconds):\n";
+    out << std::left << std::setw(10) << "Operation" << std::right
+        << std::setw(10) << "Count" << std::setw(8) << "Failed"
+        << std::setw(12) << "Mean" << std::setw(12) << "p50"
+        << std::setw(12) << "p90" << std::setw(12) << "p99"
+        << std::setw(12) << "Max" << "\n";
+    out << std::string(88, '-') << "\n";
+    for (size_t op = 0; op < STAT_OP_COUNT; ++op) {
+        const OpStats& s = stats.ops[op];
+        out << std::left << std::setw(10) << OP_NAMES[op] << std::right
+            << std::setw(10) << s.count << std::setw(8) << s.failed
+            << std::setw(12) << formatMicros(s.meanNs())
+            << std::setw(12) << formatMicros(static_cast<double>(s.p50Ns))
+            << std::setw(12) << formatMicros(static_cast<double>(s.p90Ns))
+            << std::setw(12) << formatMicros(static_cast<double>(s.p99Ns))
+            << std::setw(12) << formatMicros(static_cast<double>(s.maxNs)) << "\n";
+    }
+    out << std::string(88, '-') << "\n";
+}
+
+}  // namespace SchedulerStats
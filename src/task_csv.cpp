@@ -0,0 +1,252 @@
+#include "task_csv.hpp"
+#include "mapped_file.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <thread>
+
+const char* const TaskCsv::HEADER = "TaskID,Priority,NotBefore,Deadline,Description";
+
+namespace {
+
+const size_t MIN_CHUNK_BYTES = 1 << 20;  // Smaller files parse on one thread
+const size_t WRITE_BUFFER_BYTES = 1 << 20;
+
+struct ChunkResult {
+    std::vector<Task> tasks;
+    std::vector<CsvParseError> errors;  // Line numbers relative to the chunk
+    size_t lines = 0;
+    std::string unquoted;  // Reused for descriptions that need unescaping
+};
+
+// Unquoted descriptions are viewed in place; quoted ones are unescaped into
+// scratch, which the view then points at
+bool parseDescription(const char* p, const char* end, std::string& scratch,
+                      std::string_view& description, const char*& error) {
+    if (p == end || *p != '"') {
+        description = std::string_view(p, end - p);  // The rest of the line
+        return true;
+    }
+
+    ++p;
+    scratch.clear();
+    while (true) {
+        const char* quote = static_cast<const char*>(std::memchr(p, '"', end - p));
+        if (quote == nullptr) {
+            error = "unterminated quoted description";
+            return false;
+        }
+        scratch.append(p, quote);
+        if (quote + 1 < end && quote[1] == '"') {
+            scratch += '"';
+            p = quote + 2;
+            continue;
+        }
+        if (quote + 1 != end) {
+            error = "unexpected characters after quoted description";
+            return false;
+        }
+        description = scratch;
+        return true;
+    }
+}
+
+void parseLine(const char* p, const char* end, size_t line, bool timed, ChunkResult& out) {
+    int id = 0;
+    int priority = 0;
+    int64_t times[2] = {0, 0};  // NotBefore, Deadline
+
+    auto idResult = std::from_chars(p, end, id);
+    if (idResult.ec != std::errc() || idResult.ptr == end || *idResult.ptr != ',') {
+        out.errors.push_back({line, "invalid task ID"});
+        return;
+    }
+
+    p = idResult.ptr + 1;
+    auto priorityResult = std::from_chars(p, end, priority);
+    if (priorityResult.ec != std::errc() ||
+        (priorityResult.ptr != end && *priorityResult.ptr != ',')) {
+        out.errors.push_back({line, "invalid priority"});
+        return;
+    }
+
+    p = priorityResult.ptr == end ? end : priorityResult.ptr + 1;
+    if (timed) {
+        for (int64_t& time : times) {
+            auto timeResult = std::from_chars(p, end, time);
+            if (timeResult.ec != std::errc() || timeResult.ptr == end || *timeResult.ptr != ',') {
+                out.errors.push_back({line, "invalid timestamp"});
+                return;
+            }
+            p = timeResult.ptr + 1;
+        }
+    }
+
+    std::string_view description;
+    const char* error = nullptr;
+    if (!parseDescription(p, end, out.unquoted, description, error)) {
+        out.errors.push_back({line, error});
+        return;
+    }
+
+    out.tasks.emplace_back(id, description, priority);
+    out.tasks.back().setNotBefore(times[0]);
+    out.tasks.back().setDeadline(times[1]);
+}
+
+void parseChunk(const char* begin, const char* end, bool timed, ChunkResult& out) {
+    // Rough reservation; rows are rarely shorter than this
+    out.tasks.reserve(static_cast<size_t>(end - begin) / 24);
+
+    const char* p = begin;
+    while (p < end) {
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        const char* lineEnd = newline != nullptr ? newline : end;
+        ++out.lines;
+
+        const char* contentEnd = lineEnd;
+        if (contentEnd > p && contentEnd[-1] == '\r') --contentEnd;
+        if (contentEnd > p) {
+            parseLine(p, contentEnd, out.lines, timed, out);
+        }
+        p = lineEnd + 1;
+    }
+}
+
+void appendDescription(std::string& out, std::string_view description) {
+    bool needsQuotes = description.find_first_of(",\"\r\n") != std::string_view::npos;
+    if (!needsQuotes) {
+        out += description;
+        return;
+    }
+
+    out += '"';
+    for (char c : description) {
+        if (c == '"') {
+            out += "\"\"";
+        } else if (c == '\n' || c == '\r') {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+template <typename Int>
+void appendInt(std::string& out, Int value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+}  // namespace
+
+CsvLoadResult TaskCsv::load(const std::string& path, unsigned threads) {
+    CsvLoadResult result;
+    MappedFile file;
+    if (!file.open(path)) return result;
+    result.opened = true;
+    if (file.size() == 0) return result;
+
+    const char* data = file.data();
+    const char* end = data + file.size();
+    const char* begin = data;
+    size_t headerLines = 0;
+    bool timed = false;
+
+    // Skip the header row when present; it tells the timed layout from the
+    // original TaskID,Priority,Description one
+    if (*begin != '-' && (*begin < '0' || *begin > '9')) {
+        const char* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        const char* headerEnd = newline != nullptr ? newline : end;
+        timed = std::string_view(begin, headerEnd - begin).find("NotBefore") != std::string_view::npos;
+        begin = newline != nullptr ? newline + 1 : end;
+        headerLines = 1;
+    }
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t bytes = static_cast<size_t>(end - begin);
+    size_t chunkCount = std::max<size_t>(1, std::min<size_t>(threads, bytes / MIN_CHUNK_BYTES));
+
+    // Split at the first newline after each even cut so chunks hold whole rows
+    std::vector<const char*> bounds{begin};
+    for (size_t k = 1; k < chunkCount; ++k) {
+        const char* cut = std::max(begin + bytes * k / chunkCount, bounds.back());
+        const char* newline = static_cast<const char*>(std::memchr(cut, '\n', end - cut));
+        bounds.push_back(newline != nullptr ? newline + 1 : end);
+    }
+    bounds.push_back(end);
+
+    std::vector<ChunkResult> chunks(chunkCount);
+    std::vector<std::thread> workers;
+    for (size_t k = 1; k < chunkCount; ++k) {
+        workers.emplace_back(parseChunk, bounds[k], bounds[k + 1], timed, std::ref(chunks[k]));
+    }
+    parseChunk(bounds[0], bounds[1], timed, chunks[0]);
+    for (auto& worker : workers) worker.join();
+
+    // Merge: each chunk moves its rows into its own range of the output
+    if (chunkCount == 1) {
+        result.tasks = std::move(chunks[0].tasks);
+    } else {
+        std::vector<size_t> offsets{0};
+        for (const auto& chunk : chunks) offsets.push_back(offsets.back() + chunk.tasks.size());
+        result.tasks.resize(offsets.back());
+
+        auto moveChunk = [&](size_t k) {
+            std::move(chunks[k].tasks.begin(), chunks[k].tasks.end(), result.tasks.begin() + offsets[k]);
+            std::vector<Task>().swap(chunks[k].tasks);
+        };
+        workers.clear();
+        for (size_t k = 1; k < chunkCount; ++k) {
+            workers.emplace_back(moveChunk, k);
+        }
+        moveChunk(0);
+        for (auto& worker : workers) worker.join();
+    }
+
+    size_t lineOffset = headerLines;
+    for (auto& chunk : chunks) {
+        for (auto& error : chunk.errors) {
+            result.errors.push_back({lineOffset + error.line, std::move(error.message)});
+        }
+        lineOffset += chunk.lines;
+    }
+    return result;
+}
+
+void TaskCsv::appendRow(std::string& out, const Task& task) {
+    appendInt(out, task.getId());
+    out += ',';
+    appendInt(out, task.getPriority());
+    out += ',';
+    appendInt(out, task.getNotBefore());
+    out += ',';
+    appendInt(out, task.getDeadline());
+    out += ',';
+    appendDescription(out, task.getDescription());
+    out += '\n';
+}
+
+bool TaskCsv::write(const std::string& path, const std::vector<Task>& tasks) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    std::string buffer;
+    buffer.reserve(WRITE_BUFFER_BYTES + 256);
+    buffer += HEADER;
+    buffer += '\n';
+    for (const auto& task : tasks) {
+        appendRow(buffer, task);
+        if (buffer.size() >= WRITE_BUFFER_BYTES) {
+            file.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    file.write(buffer.data(), buffer.size());
+    return file.good();
+}
@@ -0,0 +1,274 @@
+#include "task_executor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+
+TaskExecutor::TaskExecutor(ConcurrentScheduler& taskScheduler, FileManager* logTarget,
+                           const ExecutorConfig& executorConfig)
+    : scheduler(taskScheduler),
+      fileManager(logTarget),
+      config(executorConfig),
+      workShards(taskScheduler.getShardCount()),
+      completedTasks(executorConfig.historyLimit) {
+    size_t count = config.workers != 0 ? config.workers
+                                       : std::max(1u, std::thread::hardware_concurrency());
+    if (config.batchSize == 0) config.batchSize = 1;
+
+    completionThread = std::thread(&TaskExecutor::completionLoop, this);
+    for (size_t i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < count; ++i) {
+        workers[i]->thread = std::thread(&TaskExecutor::workerLoop, this, i);
+    }
+}
+
+TaskExecutor::~TaskExecutor() {
+    stop();
+}
+
+TaskExecutor::WorkShard& TaskExecutor::shardFor(int taskId) {
+    return workShards[static_cast<uint32_t>(taskId) % workShards.size()];
+}
+
+std::function<void()> TaskExecutor::takeWork(int taskId) {
+    WorkShard& shard = shardFor(taskId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.work.find(taskId);
+    if (it == shard.work.end()) {
+        return nullptr;  // Scheduled without a callable
+    }
+    std::function<void()> work = std::move(it->second);
+    shard.work.erase(it);
+    return work;
+}
+
+void TaskExecutor::submit(const Task& task, std::function<void()> work) {
+    {
+        // A callable is held only while its task is in the scheduler, so an
+        // existing entry means a duplicate ID; leave the queued task's work alone
+        WorkShard& shard = shardFor(task.getId());
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.work.try_emplace(task.getId(), std::move(work)).second) {
+            throw std::runtime_error("Task ID already exists. Please use a unique ID.");
+        }
+    }
+    try {
+        scheduler.addTask(task);
+    } catch (...) {
+        takeWork(task.getId());
+        throw;
+    }
+    workAvailable.notify_one();
+}
+
+Task TaskExecutor::cancel(int taskId) {
+    return scheduler.cancelTask(taskId, [this](const Task& task) { takeWork(task.getId()); });
+}
+
+bool TaskExecutor::popLocal(Worker& worker, Job& job) {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.jobs.empty()) {
+        return false;
+    }
+    job = std::move(worker.jobs.front());
+    worker.jobs.pop_front();
+    return true;
+}
+
+bool TaskExecutor::refill(Worker& worker) {
+    std::vector<Job> batch;
+    Task task;
+    std::function<void()> work;
+    ConcurrentScheduler::TakenCallback takeCallable = [&](const Task& taken) {
+        work = takeWork(taken.getId());
+    };
+    for (size_t i = 0; i < config.batchSize; ++i) {
+        // Count the job before it leaves the scheduler so waitIdle never
+        // sees it in neither place
+        inFlight.fetch_add(1);
+        if (!scheduler.tryRemoveHighestPriorityTask(task, takeCallable)) {
+            inFlight.fetch_sub(1);
+            break;
+        }
+        batch.push_back({task, std::move(work)});
+    }
+    if (batch.empty()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    for (auto& job : batch) {
+        worker.jobs.push_back(std::move(job));
+    }
+    return true;
+}
+
+bool TaskExecutor::steal(size_t thief, Job& job) {
+    // Take from the back: the victim's lowest-priority work
+    for (size_t offset = 1; offset < workers.size(); ++offset) {
+        Worker& victim = *workers[(thief + offset) % workers.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (lock.owns_lock() && !victim.jobs.empty()) {
+            job = std::move(victim.jobs.back());
+            victim.jobs.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskExecutor::run(Job& job, std::vector<CompletedTask>& finished) {
+    if (job.work) {
+        try {
+            job.work();
+        } catch (const std::exception& e) {
+            if (fileManager != nullptr) {
+                fileManager->logAction("Task failed: " + std::string(e.what()), job.task);
+            }
+        } catch (...) {
+            if (fileManager != nullptr) {
+                fileManager->logAction("Task failed with an unknown exception", job.task);
+            }
+        }
+    }
+    int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    finished.push_back({std::move(job.task), nowMs});
+    completed.fetch_add(1, std::memory_order_release);
+    if (inFlight.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        allDone.notify_all();
+    }
+}
+
+void TaskExecutor::publishCompletions(std::vector<CompletedTask>& finished) {
+    if (finished.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(completionMutex);
+        for (auto& entry : finished) {
+            pendingCompletions.push_back(std::move(entry));
+        }
+    }
+    finished.clear();
+    completionReady.notify_one();
+}
+
+void TaskExecutor::workerLoop(size_t index) {
+    Worker& self = *workers[index];
+    std::vector<CompletedTask> finished;
+    const size_t publishEvery = 32;
+    Job job;
+
+    while (running.load(std::memory_order_acquire)) {
+        if (popLocal(self, job) || (refill(self) && popLocal(self, job)) || steal(index, job)) {
+            run(job, finished);
+            if (finished.size() >= publishEvery) {
+                publishCompletions(finished);
+            }
+            continue;
+        }
+
+        publishCompletions(finished);
+        std::unique_lock<std::mutex> lock(idleMutex);
+        workAvailable.wait_for(lock, std::chrono::milliseconds(1));
+    }
+    publishCompletions(finished);
+}
+
+void TaskExecutor::completionLoop() {
+    std::vector<CompletedTask> batch;
+    std::vector<CompletedTask> evictions;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(completionMutex);
+            completionReady.wait(lock, [&] {
+                return !pendingCompletions.empty() || !running.load(std::memory_order_acquire);
+            });
+            if (pendingCompletions.empty()) {
+                break;  // Stopped and drained
+            }
+            batch.swap(pendingCompletions);
+        }
+
+        if (fileManager != nullptr) {
+            for (const auto& entry : batch) {
+                fileManager->logAction("Executed task", entry.task);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(completionMutex);
+            CompletedTask evicted;
+            for (auto& entry : batch) {
+                if (completedTasks.push(std::move(entry), evicted)) {
+                    evictions.push_back(std::move(evicted));
+                }
+            }
+        }
+        batch.clear();
+
+        // Archived outside the lock; getCompletedTasks never waits on a write
+        if (fileManager != nullptr) {
+            for (auto& entry : evictions) {
+                fileManager->archiveCompleted(std::move(entry));
+            }
+        }
+        evictions.clear();
+    }
+}
+
+void TaskExecutor::waitIdle() {
+    std::unique_lock<std::mutex> lock(idleMutex);
+    while (!(scheduler.isEmpty() && inFlight.load() == 0)) {
+        allDone.wait_for(lock, std::chrono::milliseconds(1));
+    }
+}
+
+void TaskExecutor::stop() {
+    if (!running.exchange(false)) return;
+
+    workAvailable.notify_all();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+
+    // Jobs already pulled into local deques go back to the scheduler
+    for (auto& worker : workers) {
+        for (auto& job : worker->jobs) {
+            // The ID was free to submit again once the job left the
+            // scheduler; if it was, the newer task keeps it
+            try {
+                submit(job.task, std::move(job.work));
+            } catch (const std::exception& e) {
+                if (fileManager != nullptr) {
+                    fileManager->logAction("Task dropped on stop: " + std::string(e.what()), job.task);
+                }
+            }
+            inFlight.fetch_sub(1);
+        }
+        worker->jobs.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(completionMutex);
+    }
+    completionReady.notify_all();
+    completionThread.join();
+
+    // The ring only lives in memory; archive it so no completion is lost
+    if (fileManager != nullptr) {
+        for (auto& entry : completedTasks.recent()) {
+            fileManager->archiveCompleted(std::move(entry));
+        }
+    }
+}
+
+std::vector<Task> TaskExecutor::getCompletedTasks() {
+    std::lock_guard<std::mutex> lock(completionMutex);
+    std::vector<Task> tasks;
+    for (auto& entry : completedTasks.recent()) {
+        tasks.push_back(std::move(entry.task));
+    }
+    return tasks;
+}
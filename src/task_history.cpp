@@ -0,0 +1,261 @@
+#include "task_history.hpp"
+#include "mapped_file.hpp"
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <string_view>
+
+namespace {
+
+const char BLOCK_MAGIC[4] = {'P', 'H', 'S', 'T'};
+
+struct BlockHeader {
+    char magic[4];
+    uint32_t count;
+    uint32_t payloadBytes;
+    uint32_t reserved;
+    uint64_t checksum;
+};
+
+static_assert(sizeof(BlockHeader) == 24, "History block header layout changed");
+
+const uint64_t CHECKSUM_SEED = 0xcbf29ce484222325ULL;
+
+// Descriptions the encoder can refer back to, direct-mapped by hash. A
+// collision forgets the older text, which costs compression, not
+// correctness, and the table never allocates.
+const size_t DICTIONARY_SLOTS = 256;
+
+uint64_t checksum(const char* data, size_t size) {
+    uint64_t hash = CHECKSUM_SEED;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+bool getVarint(const char*& p, const char* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        auto byte = static_cast<unsigned char>(*p++);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+// Decodes one block's entries into out; false on malformed payload
+bool decodeBlock(const char* p, const char* end, uint32_t count, std::vector<CompletedTask>& out) {
+    std::vector<TaskText> seen;  // Descriptions in order of first use
+    int64_t id = 0;
+    int64_t completedMs = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t idDelta, priority, timeDelta, descriptionTag;
+        if (!getVarint(p, end, idDelta) || !getVarint(p, end, priority) ||
+            !getVarint(p, end, timeDelta) || !getVarint(p, end, descriptionTag)) {
+            return false;
+        }
+        id += unzigzag(idDelta);
+        completedMs += unzigzag(timeDelta);
+
+        TaskText description;
+        if (descriptionTag & 1) {
+            uint64_t index = descriptionTag >> 1;
+            if (index >= seen.size()) return false;
+            description = seen[index];
+        } else {
+            uint64_t length = descriptionTag >> 1;
+            if (length > static_cast<uint64_t>(end - p)) return false;
+            description = TaskText(std::string_view(p, length));
+            p += length;
+            seen.push_back(description);
+        }
+        out.push_back({Task(static_cast<int>(id), std::move(description),
+                            static_cast<int>(unzigzag(priority))),
+                       completedMs});
+    }
+    return p == end;
+}
+
+// Calls visit with each block's entries in file order; returns false when
+// a torn or corrupt block stopped the scan. intact is the length of the
+// blocks read before it.
+template <typename Visit>
+bool forEachBlock(const std::string& path, uint64_t& bytes, uint64_t& intact, Visit visit) {
+    bytes = 0;
+    intact = 0;
+    MappedFile file;
+    if (!file.open(path)) return true;  // No archive yet
+    bytes = file.size();
+
+    std::vector<CompletedTask> entries;
+    const char* p = file.data();
+    const char* end = p + file.size();
+    while (p < end) {
+        BlockHeader header;
+        if (static_cast<size_t>(end - p) < sizeof(header)) return false;
+        std::memcpy(&header, p, sizeof(header));
+        p += sizeof(header);
+        if (std::memcmp(header.magic, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) != 0 ||
+            header.payloadBytes > static_cast<size_t>(end - p) ||
+            checksum(p, header.payloadBytes) != header.checksum) {
+            return false;
+        }
+        entries.clear();
+        if (!decodeBlock(p, p + header.payloadBytes, header.count, entries)) return false;
+        visit(entries);
+        p += header.payloadBytes;
+        intact = p - file.data();
+    }
+    return true;
+}
+
+}  // namespace
+
+bool HistoryRing::push(CompletedTask entry, CompletedTask& evicted) {
+    if (slots.empty()) {
+        evicted = std::move(entry);
+        return true;
+    }
+    bool full = count == slots.size();
+    if (full) {
+        evicted = std::move(slots[next]);
+    } else {
+        ++count;
+    }
+    slots[next] = std::move(entry);
+    next = next + 1 == slots.size() ? 0 : next + 1;
+    return full;
+}
+
+std::vector<CompletedTask> HistoryRing::recent() const {
+    std::vector<CompletedTask> result;
+    result.reserve(count);
+    size_t oldest = count == slots.size() ? next : 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t slot = oldest + i;
+        if (slot >= slots.size()) slot -= slots.size();
+        result.push_back(slots[slot]);
+    }
+    return result;
+}
+
+HistoryArchive::HistoryArchive(const std::string& archivePath) : path(archivePath) {}
+
+HistoryArchive::~HistoryArchive() {
+    flush();
+}
+
+void HistoryArchive::open() {
+    // Opened lazily: the data directory may not exist yet at construction.
+    // A block torn by a crash is cut off first, since readers stop at it
+    // and would never see the blocks appended after it.
+    uint64_t bytes = 0;
+    uint64_t intact = 0;
+    if (!forEachBlock(path, bytes, intact, [](std::vector<CompletedTask>&) {})) {
+        std::error_code error;
+        std::filesystem::resize_file(path, intact, error);
+    }
+    out.open(path, std::ios::app | std::ios::binary);
+}
+
+void HistoryArchive::append(CompletedTask entry) {
+    pending.push_back(std::move(entry));
+    if (pending.size() >= batchSize) {
+        flush();
+    }
+}
+
+void HistoryArchive::flush() {
+    if (pending.empty()) return;
+    if (!out.is_open()) open();
+
+    block.clear();
+    encodeBlock(block, pending);
+    out.write(block.data(), block.size());
+    out.flush();
+    pending.clear();
+}
+
+void HistoryArchive::encodeBlock(std::string& out, const std::vector<CompletedTask>& entries) {
+    size_t headerAt = out.size();
+    out.append(sizeof(BlockHeader), '\0');
+    size_t payloadAt = out.size();
+
+    struct Seen {
+        std::string_view text;  // Views into entries
+        uint64_t index;         // Position among the block's literal descriptions
+    };
+    std::array<Seen, DICTIONARY_SLOTS> seen{};
+    uint64_t literals = 0;
+    int64_t previousId = 0;
+    int64_t previousMs = 0;
+    for (const auto& entry : entries) {
+        putVarint(out, zigzag(entry.task.getId() - previousId));
+        putVarint(out, zigzag(entry.task.getPriority()));
+        putVarint(out, zigzag(entry.completedMs - previousMs));
+        previousId = entry.task.getId();
+        previousMs = entry.completedMs;
+
+        std::string_view description = entry.task.getDescription();
+        Seen& slot = seen[std::hash<std::string_view>()(description) % DICTIONARY_SLOTS];
+        if (slot.text.data() != nullptr && slot.text == description) {
+            putVarint(out, slot.index << 1 | 1);
+        } else {
+            putVarint(out, static_cast<uint64_t>(description.size()) << 1);
+            out += description;
+            slot = {description, literals++};
+        }
+    }
+
+    BlockHeader header{};
+    std::memcpy(header.magic, BLOCK_MAGIC, sizeof(BLOCK_MAGIC));
+    header.count = static_cast<uint32_t>(entries.size());
+    header.payloadBytes = static_cast<uint32_t>(out.size() - payloadAt);
+    header.checksum = checksum(out.data() + payloadAt, header.payloadBytes);
+    std::memcpy(&out[headerAt], &header, sizeof(header));
+}
+
+std::vector<CompletedTask> HistoryArchive::readAll(const std::string& path, bool* truncated) {
+    std::vector<CompletedTask> result;
+    uint64_t bytes = 0;
+    uint64_t intact = 0;
+    bool complete = forEachBlock(path, bytes, intact, [&](std::vector<CompletedTask>& entries) {
+        result.insert(result.end(), std::make_move_iterator(entries.begin()),
+                      std::make_move_iterator(entries.end()));
+    });
+    if (truncated) *truncated = !complete;
+    return result;
+}
+
+HistorySummary HistoryArchive::summarize(const std::string& path) {
+    HistorySummary summary;
+    uint64_t intact = 0;
+    bool complete = forEachBlock(path, summary.archiveBytes, intact, [&](std::vector<CompletedTask>& entries) {
+        for (const auto& entry : entries) {
+            if (summary.count == 0) summary.firstMs = entry.completedMs;
+            summary.lastMs = entry.completedMs;
+            ++summary.priorityCounts[entry.task.getPriority()];
+            ++summary.count;
+        }
+    });
+    summary.truncated = !complete;
+    return summary;
+}
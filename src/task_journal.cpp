@@ -0,0 +1,144 @@
+#include "task_journal.hpp"
+#include <filesystem>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+TaskJournal::TaskJournal(const std::string& journalPath) : path(journalPath) {
+    std::error_code ec;
+    if (fs::exists(path, ec)) {
+        bytesWritten = fs::file_size(path, ec);
+    }
+}
+
+TaskJournal::~TaskJournal() {
+    flush();
+}
+
+void TaskJournal::open() {
+    // Opened lazily: the data directory may not exist yet at construction
+    out.open(path, std::ios::app | std::ios::binary);
+}
+
+void TaskJournal::formatRecord(std::string& out, const JournalRecord& record) {
+    bool timed = record.op == JournalOp::Add && (record.notBefore != 0 || record.deadline != 0);
+    out += timed ? 'T' : static_cast<char>(record.op);
+    out += ',';
+    out += std::to_string(record.taskId);
+    if (record.op == JournalOp::Add || record.op == JournalOp::Update) {
+        out += ',';
+        out += std::to_string(record.priority);
+    }
+    if (timed) {
+        out += ',';
+        out += std::to_string(record.notBefore);
+        out += ',';
+        out += std::to_string(record.deadline);
+    }
+    if (record.op == JournalOp::Add) {
+        out += ',';
+        // Records are line-delimited, so line breaks become spaces
+        for (char c : record.description.view()) {
+            out += (c == '\n' || c == '\r') ? ' ' : c;
+        }
+    }
+    out += '\n';
+}
+
+void TaskJournal::append(const JournalRecord& record) {
+    formatRecord(pending, record);
+    if (++pendingRecords >= groupSize) {
+        flush();
+    }
+}
+
+void TaskJournal::flush() {
+    if (pending.empty()) return;
+    if (!out.is_open()) open();
+
+    out.write(pending.data(), pending.size());
+    out.flush();
+    bytesWritten += pending.size();
+    pending.clear();
+    pendingRecords = 0;
+}
+
+void TaskJournal::truncate() {
+    if (out.is_open()) out.close();
+    std::ofstream(path, std::ios::trunc);
+    pending.clear();
+    pendingRecords = 0;
+    bytesWritten = 0;
+}
+
+void TaskJournal::rotate(const std::string& retiredPath) {
+    flush();
+    if (out.is_open()) out.close();
+    if (bytesWritten == 0) return;
+
+    std::error_code ec;
+    if (!fs::exists(retiredPath, ec)) {
+        fs::rename(path, retiredPath, ec);
+    } else {
+        std::ifstream current(path, std::ios::binary);
+        std::ofstream retired(retiredPath, std::ios::app | std::ios::binary);
+        retired << current.rdbuf();
+        retired.close();
+        current.close();
+        std::ofstream(path, std::ios::trunc);
+    }
+    bytesWritten = 0;
+}
+
+std::vector<JournalRecord> TaskJournal::readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return {};
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return parseRecords(buffer.str());
+}
+
+std::vector<JournalRecord> TaskJournal::parseRecords(const std::string& contents) {
+    std::vector<JournalRecord> records;
+    size_t lineStart = 0;
+    while (lineStart < contents.size()) {
+        size_t lineEnd = contents.find('\n', lineStart);
+        // A record without its newline was torn by a crash mid-write
+        if (lineEnd == std::string::npos) break;
+
+        std::string line = contents.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        if (line.size() < 3 || line[1] != ',') continue;  // Also skips '#' comments
+        if (std::string("AXUCT").find(line[0]) == std::string::npos) continue;
+
+        bool timed = line[0] == 'T';
+        JournalRecord record{timed ? JournalOp::Add : static_cast<JournalOp>(line[0]), 0, 0, {}};
+        std::stringstream ss(line.substr(2));
+        std::string idStr, priorityStr;
+        std::getline(ss, idStr, ',');
+        try {
+            record.taskId = std::stoi(idStr);
+            if (record.op == JournalOp::Add || record.op == JournalOp::Update) {
+                std::getline(ss, priorityStr, ',');
+                record.priority = std::stoi(priorityStr);
+            }
+            if (timed) {
+                std::string notBeforeStr, deadlineStr;
+                std::getline(ss, notBeforeStr, ',');
+                std::getline(ss, deadlineStr, ',');
+                record.notBefore = std::stoll(notBeforeStr);
+                record.deadline = std::stoll(deadlineStr);
+            }
+        } catch (const std::exception&) {
+            continue;
+        }
+        if (record.op == JournalOp::Add) {
+            std::string description;
+            std::getline(ss, description);
+            record.description = TaskText(description);
+        }
+        records.push_back(std::move(record));
+    }
+    return records;
+}
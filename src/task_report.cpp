@@ -0,0 +1,301 @@
+#include "task_report.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const size_t WRITE_BUFFER_BYTES = 1 << 20;
+
+const char* const STYLE =
+    "<style>\n"
+    "body { font-family: Arial, sans-serif; margin: 40px; }\n"
+    "table { border-collapse: collapse; width: 100%; }\n"
+    "th, td { border: 1px solid #ddd; padding: 8px; text-align: left; }\n"
+    "th { background-color: #4CAF50; color: white; }\n"
+    "tr:nth-child(even) { background-color: #f2f2f2; }\n"
+    ".summary { margin-bottom: 20px; }\n"
+    ".bar { background-color: #4CAF50; height: 12px; }\n"
+    ".pages a { margin-right: 6px; }\n"
+    "</style>\n";
+
+// Appends into one large string and writes it out a block at a time
+class BufferedWriter {
+private:
+    std::ofstream file;
+    std::string buffer;
+
+public:
+    explicit BufferedWriter(const std::string& path)
+        : file(path, std::ios::binary | std::ios::trunc) {
+        buffer.reserve(WRITE_BUFFER_BYTES + 4096);
+    }
+
+    bool isOpen() const { return file.is_open(); }
+
+    BufferedWriter& operator<<(const std::string& text) {
+        buffer += text;
+        return *this;
+    }
+
+    BufferedWriter& operator<<(const char* text) {
+        buffer += text;
+        return *this;
+    }
+
+    BufferedWriter& operator<<(uint64_t value) {
+        buffer += std::to_string(value);
+        return *this;
+    }
+
+    BufferedWriter& operator<<(int value) {
+        buffer += std::to_string(value);
+        return *this;
+    }
+
+    BufferedWriter& escaped(std::string_view text) {
+        TaskReport::appendEscaped(buffer, text);
+        return *this;
+    }
+
+    void flushIfFull() {
+        if (buffer.size() >= WRITE_BUFFER_BYTES) {
+            file.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+
+    bool finish() {
+        file.write(buffer.data(), buffer.size());
+        buffer.clear();
+        file.close();
+        return !file.fail();
+    }
+};
+
+// Sort key kept apart from the tasks so ordering moves 12 bytes, not strings
+struct RankKey {
+    int priority;
+    int id;
+    uint32_t index;
+
+    bool operator<(const RankKey& other) const {
+        return priority != other.priority ? priority < other.priority : id < other.id;
+    }
+};
+
+std::string micros(uint64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.2f", ns / 1000.0);
+    return text;
+}
+
+std::string formatTime(int64_t ms) {
+    std::time_t seconds = static_cast<std::time_t>(ms / 1000);
+    std::tm local{};
+    localtime_r(&seconds, &local);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+    return text;
+}
+
+void writeTaskRow(BufferedWriter& out, size_t rank, const Task& task) {
+    out << "<tr><td>" << static_cast<uint64_t>(rank) << "</td><td>" << task.getId()
+        << "</td><td>" << task.getPriority() << "</td><td>";
+    out.escaped(task.getDescription()) << "</td></tr>\n";
+    out.flushIfFull();
+}
+
+void writeHeader(BufferedWriter& out) {
+    out << "<!DOCTYPE html>\n<html>\n<head>\n<meta charset='utf-8'>\n" << STYLE << "</head>\n<body>\n";
+}
+
+void writeHistogram(BufferedWriter& out, const char* title, const std::map<int, uint64_t>& counts) {
+    uint64_t largest = 0;
+    for (const auto& entry : counts) largest = std::max(largest, entry.second);
+
+    out << "<h3>" << title << "</h3>\n"
+        << "<table>\n<tr><th>Priority</th><th>Tasks</th><th></th></tr>\n";
+    for (const auto& entry : counts) {
+        uint64_t width = largest == 0 ? 0 : entry.second * 100 / largest;
+        out << "<tr><td>" << entry.first << "</td><td>" << entry.second
+            << "</td><td><div class='bar' style='width:" << width << "%'></div></td></tr>\n";
+    }
+    out << "</table>\n";
+}
+
+void writeArchivedHistory(BufferedWriter& out, const HistorySummary& history) {
+    out << "<h3>Archived Completions</h3>\n";
+    if (history.count == 0) {
+        out << "<p>No completions have been archived yet.</p>\n";
+    } else {
+        out << "<p>" << history.count << " tasks completed between " << formatTime(history.firstMs)
+            << " and " << formatTime(history.lastMs) << " (" << history.archiveBytes
+            << " bytes archived)</p>\n";
+        writeHistogram(out, "Archived Completions by Priority", history.priorityCounts);
+    }
+    if (history.truncated) {
+        out << "<p>The archive ends in a damaged block; later entries were skipped.</p>\n";
+    }
+}
+
+void writeStats(BufferedWriter& out, const StatsSnapshot& stats) {
+    out << "<h3>Operation Latency</h3>\n";
+    if (!stats.enabled) {
+        out << "<p>Statistics were disabled at compile time.</p>\n";
+        return;
+    }
+    out << "<table>\n"
+        << "<tr><th>Operation</th><th>Count</th><th>Failed</th><th>Mean (&micro;s)</th>"
+        << "<th>p50 (&micro;s)</th><th>p90 (&micro;s)</th><th>p99 (&micro;s)</th>"
+        << "<th>Max (&micro;s)</th></tr>\n";
+    for (size_t op = 0; op < STAT_OP_COUNT; ++op) {
+        const OpStats& s = stats.ops[op];
+        out << "<tr><td>" << SchedulerStats::opName(static_cast<StatOp>(op)) << "</td>"
+            << "<td>" << s.count << "</td>"
+            << "<td>" << s.failed << "</td>"
+            << "<td>" << micros(static_cast<uint64_t>(s.meanNs())) << "</td>"
+            << "<td>" << micros(s.p50Ns) << "</td>"
+            << "<td>" << micros(s.p90Ns) << "</td>"
+            << "<td>" << micros(s.p99Ns) << "</td>"
+            << "<td>" << micros(s.maxNs) << "</td></tr>\n";
+    }
+    out << "</table>\n";
+}
+
+void writePageLinks(BufferedWriter& out, const std::string& stem, size_t pageCount) {
+    out << "<p class='pages'>";
+    for (size_t page = 1; page <= pageCount; ++page) {
+        out << "<a href='" << fs::path(TaskReport::pagePath(stem, page)).filename().string() << "'>"
+            << static_cast<uint64_t>(page) << "</a>";
+        if (page % 50 == 0) out.flushIfFull();
+    }
+    out << "</p>\n";
+}
+
+bool writePage(const std::string& stem, size_t page, size_t pageCount, const ReportData& data,
+               const std::vector<RankKey>& order, size_t pageSize) {
+    BufferedWriter out(TaskReport::pagePath(stem, page));
+    if (!out.isOpen()) return false;
+
+    std::string index = fs::path(stem + ".html").filename().string();
+    writeHeader(out);
+    out << "<h2>Task Scheduler Report - " << data.timestamp << "</h2>\n"
+        << "<p><a href='" << index << "'>Summary</a>";
+    if (page > 1) {
+        out << " | <a href='" << fs::path(TaskReport::pagePath(stem, page - 1)).filename().string()
+            << "'>Previous</a>";
+    }
+    if (page < pageCount) {
+        out << " | <a href='" << fs::path(TaskReport::pagePath(stem, page + 1)).filename().string()
+            << "'>Next</a>";
+    }
+    out << "</p>\n<h3>All Active Tasks - page " << static_cast<uint64_t>(page) << " of "
+        << static_cast<uint64_t>(pageCount) << "</h3>\n"
+        << "<table>\n<tr><th>Rank</th><th>ID</th><th>Priority</th><th>Description</th></tr>\n";
+
+    size_t first = (page - 1) * pageSize;
+    size_t last = std::min(order.size(), first + pageSize);
+    for (size_t rank = first; rank < last; ++rank) {
+        writeTaskRow(out, rank + 1, data.tasks[order[rank].index]);
+    }
+    out << "</table>\n</body>\n</html>\n";
+    return out.finish();
+}
+
+}  // namespace
+
+void TaskReport::appendEscaped(std::string& out, std::string_view text) {
+    for (char c : text) {
+        switch (c) {
+            case '&': out += "&amp;"; break;
+            case '<': out += "&lt;"; break;
+            case '>': out += "&gt;"; break;
+            case '"': out += "&quot;"; break;
+            case '\'': out += "&#39;"; break;
+            default: out += c;
+        }
+    }
+}
+
+std::string TaskReport::pagePath(const std::string& stem, size_t page) {
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), "_p%04zu", page);
+    return stem + suffix + ".html";
+}
+
+bool TaskReport::write(const std::string& stem, ReportData& data, const ReportConfig& config) {
+    std::vector<RankKey> order;
+    order.reserve(data.tasks.size());
+    for (size_t i = 0; i < data.tasks.size(); ++i) {
+        order.push_back({data.tasks[i].getPriority(), data.tasks[i].getId(), static_cast<uint32_t>(i)});
+    }
+
+    // Top-K in O(n + k log k): select the k best, then sort only those
+    size_t topK = std::min(config.topK, order.size());
+    if (topK < order.size()) {
+        std::nth_element(order.begin(), order.begin() + topK, order.end());
+    }
+    std::sort(order.begin(), order.begin() + topK);
+
+    size_t pageSize = config.pageSize == 0 ? 1 : config.pageSize;
+    size_t pageCount = (order.size() + pageSize - 1) / pageSize;
+
+    BufferedWriter out(stem + ".html");
+    if (!out.isOpen()) return false;
+
+    writeHeader(out);
+    out << "<div class='summary'>\n"
+        << "<h2>Task Scheduler Report - " << data.timestamp << "</h2>\n"
+        << "<p>Total Active Tasks: " << static_cast<uint64_t>(data.tasks.size()) << "</p>\n"
+        << "<p>Total Completed Tasks: "
+        << static_cast<uint64_t>(data.recentCompleted.size()) + data.archivedHistory.count << "</p>\n"
+        << "</div>\n";
+
+    out << "<h3>Top " << static_cast<uint64_t>(topK) << " Active Tasks</h3>\n"
+        << "<table>\n<tr><th>Rank</th><th>ID</th><th>Priority</th><th>Description</th></tr>\n";
+    for (size_t rank = 0; rank < topK; ++rank) {
+        writeTaskRow(out, rank + 1, data.tasks[order[rank].index]);
+    }
+    out << "</table>\n";
+
+    if (pageCount > 0) {
+        out << "<h3>All Active Tasks</h3>\n";
+        writePageLinks(out, stem, pageCount);
+    }
+
+    std::map<int, uint64_t> counts;
+    for (const auto& task : data.tasks) {
+        ++counts[task.getPriority()];
+    }
+    writeHistogram(out, "Priority Histogram", counts);
+
+    // Newest first
+    out << "<h3>Recently Completed Tasks</h3>\n"
+        << "<table>\n<tr><th>Completed</th><th>ID</th><th>Priority</th><th>Description</th></tr>\n";
+    for (auto it = data.recentCompleted.rbegin(); it != data.recentCompleted.rend(); ++it) {
+        out << "<tr><td>" << formatTime(it->completedMs) << "</td><td>" << it->task.getId()
+            << "</td><td>" << it->task.getPriority() << "</td><td>";
+        out.escaped(it->task.getDescription()) << "</td></tr>\n";
+    }
+    out << "</table>\n";
+
+    writeArchivedHistory(out, data.archivedHistory);
+
+    writeStats(out, data.stats);
+    out << "</body>\n</html>\n";
+    if (!out.finish()) return false;
+
+    // The listing pages need the rest of the order; the top-K prefix is done
+    std::sort(order.begin() + topK, order.end());
+    for (size_t page = 1; page <= pageCount; ++page) {
+        if (!writePage(stem, page, pageCount, data, order, pageSize)) return false;
+    }
+    return true;
+}
@@ -0,0 +1,186 @@
+#include "task_snapshot.hpp"
+#include "mapped_file.hpp"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+
+// Headers and records are copied to and from the file in host byte order
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "Task snapshots are little-endian; this host is not"
+#endif
+
+namespace {
+
+const char MAGIC[8] = {'P', 'R', 'I', 'O', 'H', 'E', 'A', 'T'};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t taskCount;
+    uint64_t stringBytes;
+    uint64_t checksum;
+    uint64_t reserved;
+};
+
+struct SnapshotRecordV1 {
+    int32_t taskId;
+    int32_t priority;
+    uint32_t descriptionOffset;
+    uint32_t descriptionLength;
+};
+
+struct SnapshotRecord {
+    int32_t taskId;
+    int32_t priority;
+    uint32_t descriptionOffset;
+    uint32_t descriptionLength;
+    int64_t notBefore;
+    int64_t deadline;
+};
+
+static_assert(sizeof(SnapshotHeader) == 48, "Snapshot header layout changed");
+static_assert(sizeof(SnapshotRecordV1) == 16, "Snapshot record layout changed");
+static_assert(sizeof(SnapshotRecord) == 32, "Snapshot record layout changed");
+
+// Word-at-a-time FNV-style hash; cheap enough to run over every load
+uint64_t checksum(const char* data, size_t size, uint64_t hash) {
+    const uint64_t prime = 0x100000001b3ULL;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+    }
+    return hash;
+}
+
+const uint64_t CHECKSUM_SEED = 0xcbf29ce484222325ULL;
+
+}  // namespace
+
+bool TaskSnapshot::isSnapshotFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    return file.gcount() == sizeof(magic) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool TaskSnapshot::write(const std::string& path, const std::vector<Task>& tasks) {
+    std::vector<SnapshotRecord> records;
+    records.reserve(tasks.size());
+    std::string strings;
+    std::unordered_map<std::string_view, uint32_t> offsets;  // Views into tasks, which outlive the call
+
+    for (const auto& task : tasks) {
+        std::string_view description = task.getDescription();
+        auto it = offsets.find(description);
+        uint32_t offset;
+        if (it != offsets.end()) {
+            offset = it->second;
+        } else {
+            if (strings.size() + description.size() > std::numeric_limits<uint32_t>::max()) {
+                return false;  // String table offsets are 32-bit
+            }
+            offset = static_cast<uint32_t>(strings.size());
+            strings += description;
+            offsets.emplace(description, offset);
+        }
+        records.push_back({task.getId(), task.getPriority(), offset,
+                           static_cast<uint32_t>(description.size()),
+                           task.getNotBefore(), task.getDeadline()});
+    }
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.recordSize = sizeof(SnapshotRecord);
+    header.taskCount = records.size();
+    header.stringBytes = strings.size();
+    const char* recordBytes = reinterpret_cast<const char*>(records.data());
+    size_t recordsSize = records.size() * sizeof(SnapshotRecord);
+    header.checksum = checksum(strings.data(), strings.size(),
+                               checksum(recordBytes, recordsSize, CHECKSUM_SEED));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(recordBytes, recordsSize);
+    file.write(strings.data(), strings.size());
+    return file.good();
+}
+
+SnapshotLoadResult TaskSnapshot::load(const std::string& path) {
+    SnapshotLoadResult result;
+    MappedFile file;
+    if (!file.open(path)) return result;
+    result.opened = true;
+
+    SnapshotHeader header;
+    if (file.size() < sizeof(header)) {
+        result.error = "file too small for a snapshot header";
+        return result;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        result.error = "not a task snapshot";
+        return result;
+    }
+    if (header.version != 1 && header.version != VERSION) {
+        result.error = "unsupported snapshot version " + std::to_string(header.version);
+        return result;
+    }
+    size_t recordSize = header.version == 1 ? sizeof(SnapshotRecordV1) : sizeof(SnapshotRecord);
+    if (header.recordSize != recordSize) {
+        result.error = "unexpected record size " + std::to_string(header.recordSize);
+        return result;
+    }
+
+    size_t available = file.size() - sizeof(header);
+    if (header.taskCount > available / recordSize ||
+        header.stringBytes != available - header.taskCount * recordSize) {
+        result.error = "snapshot is truncated or has trailing data";
+        return result;
+    }
+
+    const char* recordBytes = file.data() + sizeof(header);
+    size_t recordsSize = header.taskCount * recordSize;
+    const char* strings = recordBytes + recordsSize;
+    uint64_t actual = checksum(strings, header.stringBytes,
+                               checksum(recordBytes, recordsSize, CHECKSUM_SEED));
+    if (actual != header.checksum) {
+        result.error = "checksum mismatch";
+        return result;
+    }
+
+    // The writer stores each distinct description once; tasks that share an
+    // entry share one TaskText as well
+    std::unordered_map<uint64_t, TaskText> texts;  // Keyed by offset and length
+    result.tasks.reserve(header.taskCount);
+    for (uint64_t i = 0; i < header.taskCount; ++i) {
+        SnapshotRecord record{};
+        std::memcpy(&record, recordBytes + i * recordSize, recordSize);
+        if (static_cast<uint64_t>(record.descriptionOffset) + record.descriptionLength > header.stringBytes) {
+            result.error = "record " + std::to_string(i) + " points outside the string table";
+            result.tasks.clear();
+            return result;
+        }
+        auto [text, added] = texts.try_emplace(
+            static_cast<uint64_t>(record.descriptionOffset) << 32 | record.descriptionLength);
+        if (added) {
+            text->second = TaskText(std::string_view(strings + record.descriptionOffset,
+                                                     record.descriptionLength));
+        }
+        result.tasks.emplace_back(record.taskId, text->second, record.priority);
+        result.tasks.back().setNotBefore(record.notBefore);
+        result.tasks.back().setDeadline(record.deadline);
+    }
+    return result;
+}
@@ -0,0 +1,44 @@
+#include "task_text.hpp"
+#include <cstring>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+
+namespace {
+
+std::pmr::memory_resource& textPool() {
+    // Leaked so tasks held by static objects can still release their text
+    static auto* pool = new std::pmr::synchronized_pool_resource();
+    return *pool;
+}
+
+}  // namespace
+
+TaskText::TaskText(std::string_view text) : bytes{} {
+    if (text.size() <= INLINE_CAPACITY) {
+        text.copy(bytes, text.size());
+        setTag(static_cast<uint8_t>(text.size()));
+        return;
+    }
+    if (text.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Task description too long");
+    }
+    void* memory = textPool().allocate(sizeof(Block) + text.size(), alignof(Block));
+    Block* created = new (memory) Block{{1}, static_cast<uint32_t>(text.size())};
+    std::memcpy(created->data(), text.data(), text.size());
+    std::memcpy(bytes, &created, sizeof(created));
+    setTag(IN_BLOCK);
+}
+
+void TaskText::release() noexcept {
+    if (inBlock()) {
+        Block* shared = block();
+        if (shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            size_t size = sizeof(Block) + shared->length;
+            shared->~Block();
+            textPool().deallocate(shared, size, alignof(Block));
+        }
+    }
+    setTag(0);
+}
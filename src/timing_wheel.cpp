@@ -0,0 +1,239 @@
+#include "timing_wheel.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+// Slots of a level above position, as a mask over its occupancy bitmap
+uint64_t slotsAfter(int position) {
+    return position >= 63 ? 0 : ~0ULL << (position + 1);
+}
+
+}  // namespace
+
+TimingWheel::TimingWheel(int64_t tickMilliseconds, int64_t nowMs)
+    : tickMs(tickMilliseconds > 0 ? tickMilliseconds : 1),
+      currentTick(nowMs > 0 ? static_cast<uint64_t>(nowMs / tickMs) : 0),
+      heads(OVERFLOW_SLOT + 1, -1) {}
+
+uint64_t TimingWheel::tickFor(int64_t timeMs) const {
+    // Round up so a timer never fires before its time
+    if (timeMs <= 0) return 0;
+    return static_cast<uint64_t>((timeMs + tickMs - 1) / tickMs);
+}
+
+int TimingWheel::allocate(const Task& task, uint64_t expiry, Kind kind) {
+    int node;
+    if (!freeNodes.empty()) {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[node] = {task, expiry, -1, -1, -1, kind};
+    } else {
+        node = static_cast<int>(nodes.size());
+        nodes.push_back({task, expiry, -1, -1, -1, kind});
+    }
+    return node;
+}
+
+void TimingWheel::place(int node) {
+    // The lowest level whose window (relative to now) contains the expiry
+    uint64_t expiry = nodes[node].expiry;
+    for (int level = 0; level < LEVELS; ++level) {
+        int shift = SLOT_BITS * (level + 1);
+        if ((expiry >> shift) == (currentTick >> shift)) {
+            int slot = static_cast<int>((expiry >> (SLOT_BITS * level)) & (SLOTS - 1));
+            link(node, level * SLOTS + slot);
+            return;
+        }
+    }
+    link(node, OVERFLOW_SLOT);
+}
+
+void TimingWheel::link(int node, int slot) {
+    Node& n = nodes[node];
+    n.slot = slot;
+    n.prev = -1;
+    n.next = heads[slot];
+    if (n.next != -1) {
+        nodes[n.next].prev = node;
+    }
+    heads[slot] = node;
+    if (slot < OVERFLOW_SLOT) {
+        occupied[slot / SLOTS] |= 1ULL << (slot % SLOTS);
+    }
+}
+
+void TimingWheel::unlink(int node) {
+    Node& n = nodes[node];
+    if (n.prev != -1) {
+        nodes[n.prev].next = n.next;
+    } else {
+        heads[n.slot] = n.next;
+    }
+    if (n.next != -1) {
+        nodes[n.next].prev = n.prev;
+    }
+    if (heads[n.slot] == -1 && n.slot < OVERFLOW_SLOT) {
+        occupied[n.slot / SLOTS] &= ~(1ULL << (n.slot % SLOTS));
+    }
+}
+
+int TimingWheel::detachSlot(int slot) {
+    int head = heads[slot];
+    heads[slot] = -1;
+    if (slot < OVERFLOW_SLOT) {
+        occupied[slot / SLOTS] &= ~(1ULL << (slot % SLOTS));
+    }
+    return head;
+}
+
+Task TimingWheel::releaseNode(int node) {
+    Task task = std::move(nodes[node].task);
+    nodes[node].task = Task();
+    freeNodes.push_back(node);
+    return task;
+}
+
+bool TimingWheel::scheduleRelease(const Task& task) {
+    uint64_t expiry = tickFor(task.getNotBefore());
+    if (expiry <= currentTick) {
+        return false;
+    }
+    int node = allocate(task, expiry, Kind::Release);
+    place(node);
+    releaseIndex[task.getId()] = node;
+    return true;
+}
+
+void TimingWheel::scheduleDeadline(const Task& task) {
+    cancelDeadline(task.getId());
+    uint64_t expiry = std::max(tickFor(task.getDeadline()), currentTick + 1);
+    int node = allocate(task, expiry, Kind::Deadline);
+    place(node);
+    deadlineIndex[task.getId()] = node;
+}
+
+bool TimingWheel::cancelRelease(int taskId, Task& removed) {
+    auto it = releaseIndex.find(taskId);
+    if (it == releaseIndex.end()) {
+        return false;
+    }
+    int node = it->second;
+    releaseIndex.erase(it);
+    unlink(node);
+    removed = releaseNode(node);
+    return true;
+}
+
+void TimingWheel::cancelDeadline(int taskId) {
+    auto it = deadlineIndex.find(taskId);
+    if (it == deadlineIndex.end()) {
+        return;
+    }
+    int node = it->second;
+    deadlineIndex.erase(it);
+    unlink(node);
+    releaseNode(node);
+}
+
+bool TimingWheel::updatePriority(int taskId, int newPriority) {
+    // The deadline copy is what the expiry callback sees, so keep it current
+    auto deadline = deadlineIndex.find(taskId);
+    if (deadline != deadlineIndex.end()) {
+        nodes[deadline->second].task.setPriority(newPriority);
+    }
+    auto release = releaseIndex.find(taskId);
+    if (release == releaseIndex.end()) {
+        return false;
+    }
+    nodes[release->second].task.setPriority(newPriority);
+    return true;
+}
+
+std::vector<Task> TimingWheel::pendingTasks() const {
+    std::vector<Task> tasks;
+    tasks.reserve(releaseIndex.size());
+    for (const auto& entry : releaseIndex) {
+        tasks.push_back(nodes[entry.second].task);
+    }
+    return tasks;
+}
+
+void TimingWheel::clear() {
+    nodes.clear();
+    freeNodes.clear();
+    std::fill(heads.begin(), heads.end(), -1);
+    std::fill(std::begin(occupied), std::end(occupied), 0);
+    releaseIndex.clear();
+    deadlineIndex.clear();
+}
+
+uint64_t TimingWheel::nextEventTick() const {
+    uint64_t next = UINT64_MAX;
+    for (int level = 0; level < LEVELS; ++level) {
+        int shift = SLOT_BITS * level;
+        int position = static_cast<int>((currentTick >> shift) & (SLOTS - 1));
+        uint64_t later = occupied[level] & slotsAfter(position);
+        if (later != 0) {
+            // Level 0 slots fire; higher slots cascade when their span begins
+            uint64_t windowStart = (currentTick >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+            uint64_t slot = static_cast<uint64_t>(__builtin_ctzll(later));
+            next = std::min(next, windowStart + (slot << shift));
+        }
+    }
+    if (heads[OVERFLOW_SLOT] != -1) {
+        int shift = SLOT_BITS * LEVELS;
+        next = std::min(next, ((currentTick >> shift) + 1) << shift);
+    }
+    return next;
+}
+
+void TimingWheel::processTick(std::vector<Task>& released, std::vector<Task>& expired) {
+    // Cascade from the top down so a timer can fall several levels this tick
+    int topShift = SLOT_BITS * LEVELS;
+    if ((currentTick & ((1ULL << topShift) - 1)) == 0) {
+        for (int node = detachSlot(OVERFLOW_SLOT); node != -1;) {
+            int next = nodes[node].next;
+            place(node);
+            node = next;
+        }
+    }
+    for (int level = LEVELS - 1; level >= 1; --level) {
+        int shift = SLOT_BITS * level;
+        if ((currentTick & ((1ULL << shift) - 1)) != 0) continue;
+        int slot = static_cast<int>((currentTick >> shift) & (SLOTS - 1));
+        for (int node = detachSlot(level * SLOTS + slot); node != -1;) {
+            int next = nodes[node].next;
+            place(node);
+            node = next;
+        }
+    }
+
+    for (int node = detachSlot(static_cast<int>(currentTick & (SLOTS - 1))); node != -1;) {
+        int next = nodes[node].next;
+        int taskId = nodes[node].task.getId();
+        if (nodes[node].kind == Kind::Release) {
+            releaseIndex.erase(taskId);
+            released.push_back(releaseNode(node));
+        } else {
+            deadlineIndex.erase(taskId);
+            expired.push_back(releaseNode(node));
+        }
+        node = next;
+    }
+}
+
+void TimingWheel::advance(int64_t nowMs, std::vector<Task>& released, std::vector<Task>& expired) {
+    uint64_t target = nowMs > 0 ? static_cast<uint64_t>(nowMs / tickMs) : 0;
+    while (currentTick < target) {
+        uint64_t next = nextEventTick();
+        if (next > target) {
+            // Nothing fires or cascades before target, so every timer keeps
+            // its slot relative to the new current tick
+            currentTick = target;
+            break;
+        }
+        currentTick = next;
+        processTick(released, expired);
+    }
+}